@@ -41,6 +41,9 @@ namespace SparkyStudios::UI::Pixel
 
     typedef void* PiVoidPtr;
 
+    /// Small integer interned by a renderer for a resource. 0 is never a valid handle.
+    typedef PiUInt32 PiHandle;
+
     typedef std::string PiString;
 
 #if defined(PI_WCHAR_SUPPORTED)
@@ -166,6 +166,16 @@ namespace SparkyStudios::UI::Pixel
          */
         static void Tick(PiTime time);
 
+        /**
+         * @brief Gets the earliest time at which an animation needs to be updated.
+         *
+         * @param time The total elapsed time since the start of the application.
+         *
+         * @return The time of the next needed update, which is never before the given
+         * time, or infinity if there is no running animation.
+         */
+        static PiTime GetNextTickTime(PiTime time);
+
         /**
          * @brief Construct a new animation.
          *
@@ -232,6 +242,32 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual bool Finished();
 
+        /**
+         * @brief Gets the time at which this animation needs to be updated next.
+         *
+         * By default, an animation needs to be updated as soon as possible once it
+         * has started. Animations which only need to be updated at given steps can
+         * override this to let the application sleep in between.
+         *
+         * @param time The total elapsed time since the start of the application.
+         *
+         * @return The time of the next needed update.
+         */
+        [[nodiscard]] virtual PiTime GetNextUpdateTime(PiTime time) const;
+
+        /**
+         * @brief Checks if the animation has anything to update.
+         *
+         * Animations which don't need updates are skipped by Tick(), and don't
+         * keep the application awake. Every animation needs updates by default.
+         * Looping animations which only show something in some states, like a
+         * caret blinking in a focused input, can override this to let the
+         * application sleep meanwhile.
+         *
+         * @return Whether the animation needs to be updated.
+         */
+        [[nodiscard]] virtual bool NeedsUpdate() const;
+
     protected:
         /**
          * @brief Starts the animation.
@@ -241,7 +277,7 @@ namespace SparkyStudios::UI::Pixel
         virtual void Start(PiTime time);
 
         /**
-         * @brief Process frames for this animation.
+         * @brief Process frames for this animation, and redraws the animated widget when it advanced.
          *
          * @param time The total elapsed time since the start of the application.
          */
@@ -299,6 +335,11 @@ namespace SparkyStudios::UI::Pixel
          * @brief The animation loop behavior.
          */
         bool m_loop;
+
+        /**
+         * @brief The eased progress given to Run() on the last update.
+         */
+        PiTime m_progress;
     };
 } // namespace SparkyStudios::UI::Pixel
 
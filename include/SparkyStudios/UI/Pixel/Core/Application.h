@@ -32,6 +32,25 @@ namespace SparkyStudios::UI::Pixel
     class PI_EXPORT Application
     {
     public:
+        /**
+         * @brief Defines when the main window is painted.
+         */
+        enum class RenderMode
+        {
+            /**
+             * @brief The main window is painted at a fixed rate, defined by
+             * the maximum frame rate.
+             */
+            Continuous,
+
+            /**
+             * @brief The application sleeps until an input event, a redraw
+             * request, a running animation or a key repeat needs a new frame.
+             * Frames are never painted faster than the maximum frame rate.
+             */
+            OnDemand,
+        };
+
         /**
          * @brief Get the application instance.
          */
@@ -96,16 +115,90 @@ namespace SparkyStudios::UI::Pixel
          */
         [[nodiscard]] const MainWindow* GetMainWindow() const;
 
+        /**
+         * @brief Sets the render mode of the application.
+         *
+         * @param mode The render mode.
+         */
+        void SetRenderMode(RenderMode mode);
+
+        /**
+         * @brief Gets the render mode of the application.
+         *
+         * @return The render mode.
+         */
+        [[nodiscard]] RenderMode GetRenderMode() const;
+
+        /**
+         * @brief Sets the maximum number of frames painted per second.
+         *
+         * @param fps The maximum frame rate. Must be greater than 0.
+         */
+        void SetMaxFrameRate(PiUInt32 fps);
+
+        /**
+         * @brief Gets the maximum number of frames painted per second.
+         *
+         * @return The maximum frame rate.
+         */
+        [[nodiscard]] PiUInt32 GetMaxFrameRate() const;
+
+        /**
+         * @brief Enables painting the main window on a dedicated render thread.
+         *
+         * The UI thread then only records each frame into a display list, while
+         * the render thread paints and presents it. Input handling and layout
+         * no longer wait for the GPU or for the display to present.
+         *
+         * This must be set before the application runs.
+         *
+         * @param enabled Whether the main window is painted on a render thread. Disabled by default.
+         */
+        void SetRenderThreadEnabled(bool enabled);
+
+        /**
+         * @brief Checks if the main window is painted on a dedicated render thread.
+         */
+        [[nodiscard]] bool IsRenderThreadEnabled() const;
+
+        /**
+         * @brief Sets the number of frames shared between the UI thread and the render thread.
+         *
+         * When every frame is waiting to be painted, the UI thread waits for the render thread
+         * before recording a new one. This must be set before the application runs.
+         *
+         * @param count 2 for double buffering, 3 for triple buffering.
+         */
+        void SetRenderThreadFrameCount(PiUInt32 count);
+
+        /**
+         * @brief Gets the number of frames shared between the UI thread and the render thread.
+         */
+        [[nodiscard]] PiUInt32 GetRenderThreadFrameCount() const;
+
+        /**
+         * @brief Gets the time spent loading each resource preloaded by Init().
+         *
+         * The preloaded resources are declared in the Preload section of the skin data.
+         */
+        [[nodiscard]] const std::vector<BaseRenderer::PreloadTiming>& GetPreloadTimings() const;
+
     private:
         Application();
 
         bool _initialized;
         bool _running;
+        RenderMode _renderMode;
+        PiUInt32 _maxFrameRate;
+        bool _renderThreadEnabled;
+        PiUInt32 _renderThreadFrameCount;
         MainWindow* _mainWindow;
         RelativeToExecutableResourcePaths _paths;
 
         Skin* _skin;
         BaseRenderer* _renderer;
+
+        std::vector<BaseRenderer::PreloadTiming> _preloadTimings;
     };
 } // namespace SparkyStudios::UI::Pixel
 
@@ -31,6 +31,9 @@
 
 namespace SparkyStudios::UI::Pixel
 {
+    class DisplayListRecorder;
+    struct RenderFrame;
+
     enum MAIN_WINDOW_FLAGS
     {
         MAIN_WINDOW_WINDOWED = (1 << 1),
@@ -91,6 +94,24 @@ namespace SparkyStudios::UI::Pixel
     private:
         void Paint(Skin* skin);
 
+        /**
+         * @brief Records the next frame of the root canvas, to be painted by the render thread.
+         *
+         * @param recorder The renderer of the root canvas skin.
+         * @param target The renderer painting the frames.
+         * @param frame The frame receiving the draw operations.
+         */
+        void RecordFrame(DisplayListRecorder* recorder, BaseRenderer* target, RenderFrame* frame);
+
+        /**
+         * @brief Paints and presents a recorded frame. Called from the render thread.
+         *
+         * @param renderer The renderer painting the frames.
+         * @param frame The recorded frame.
+         * @param mutex The mutex guarding the renderer against the UI thread.
+         */
+        void PaintFrame(BaseRenderer* renderer, RenderFrame* frame, std::mutex& mutex);
+
         PiVoidPtr _nativeHandle;
         int _flags;
 
@@ -102,6 +123,10 @@ namespace SparkyStudios::UI::Pixel
         CursorStyle _defaultCursorStyle;
 
         std::unique_ptr<Canvas> _rootCanvas;
+
+        // Set while a render thread owns the display.
+        bool _renderThreaded;
+        bool _resizePending;
     };
 } // namespace SparkyStudios::UI::Pixel
 
@@ -0,0 +1,107 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_ATLASPACKER_H
+#define PIXEL_UI_ATLASPACKER_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <SparkyStudios/UI/Pixel/Graphics/Rect.h>
+
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Packs rectangles into a fixed size page, using the skyline
+     * bottom-left heuristic.
+     *
+     * The packer only deals with rectangles, it doesn't depend on any
+     * rendering backend. It can be used at runtime to build texture atlases,
+     * or offline by tools.
+     */
+    class PI_EXPORT AtlasPacker
+    {
+    public:
+        /**
+         * @brief Creates a packer for an empty page.
+         *
+         * @param width The width of the page.
+         * @param height The height of the page.
+         * @param padding The space to keep free on the right and bottom of each packed rectangle.
+         */
+        AtlasPacker(PiInt32 width, PiInt32 height, PiInt32 padding = 1);
+
+        /**
+         * @brief Finds a free place for a rectangle of the given size, and marks it as used.
+         *
+         * @param width The width of the rectangle.
+         * @param height The height of the rectangle.
+         * @param region Receives the place of the rectangle in the page, without padding.
+         *
+         * @return Whether the rectangle has been packed. The page is left untouched when it has no room for it.
+         */
+        bool Pack(PiInt32 width, PiInt32 height, Rect& region);
+
+        /**
+         * @brief Marks the whole page as free.
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the width of the page.
+         */
+        [[nodiscard]] PiInt32 GetWidth() const;
+
+        /**
+         * @brief Gets the height of the page.
+         */
+        [[nodiscard]] PiInt32 GetHeight() const;
+
+        /**
+         * @brief Gets the number of rectangles packed since the page was last cleared.
+         */
+        [[nodiscard]] PiUInt32 GetCount() const;
+
+        /**
+         * @brief Gets the area covered by the packed rectangles, padding included.
+         */
+        [[nodiscard]] PiUInt64 GetUsedArea() const;
+
+        /**
+         * @brief Gets the ratio of the page area covered by packed rectangles, in the range [0, 1].
+         */
+        [[nodiscard]] PiReal32 GetOccupancy() const;
+
+    private:
+        struct SkylineNode
+        {
+            PiInt32 x, y, width;
+        };
+
+        bool Fit(std::size_t index, PiInt32 width, PiInt32 height, PiInt32& y) const;
+        void AddSkylineLevel(std::size_t index, PiInt32 x, PiInt32 y, PiInt32 width, PiInt32 height);
+
+        PiInt32 _width;
+        PiInt32 _height;
+        PiInt32 _padding;
+        PiUInt32 _count;
+        PiUInt64 _usedArea;
+        std::vector<SkylineNode> _skyline;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_ATLASPACKER_H
@@ -19,6 +19,7 @@
 
 #include <SparkyStudios/UI/Pixel/Core/Common.h>
 #include <SparkyStudios/UI/Pixel/Core/Resource.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/TextMeasureCache.h>
 
 #include <SparkyStudios/UI/Pixel/Graphics/Color.h>
 #include <SparkyStudios/UI/Pixel/Graphics/Font.h>
@@ -26,6 +27,8 @@
 #include <SparkyStudios/UI/Pixel/Graphics/Rect.h>
 #include <SparkyStudios/UI/Pixel/Graphics/Texture.h>
 
+#include <vector>
+
 namespace SparkyStudios::UI::Pixel
 {
     class MainWindow;
@@ -37,6 +40,47 @@ namespace SparkyStudios::UI::Pixel
     public:
         typedef void* CacheHandle;
 
+        /**
+         * @brief Memory usage statistics of the widget texture cache.
+         */
+        struct Stats
+        {
+            /**
+             * @brief The number of widgets which currently own a cache texture.
+             */
+            PiUInt32 entries = 0;
+
+            /**
+             * @brief The number of unused textures kept for reuse.
+             */
+            PiUInt32 pooled = 0;
+
+            /**
+             * @brief The memory used by all the cache textures, pooled ones included, in bytes.
+             */
+            PiUInt64 usedBytes = 0;
+
+            /**
+             * @brief The maximum memory the cache textures may use, in bytes.
+             */
+            PiUInt64 budgetBytes = 0;
+
+            /**
+             * @brief The number of textures created.
+             */
+            PiUInt64 allocations = 0;
+
+            /**
+             * @brief The number of textures taken from the pool instead of being created.
+             */
+            PiUInt64 reuses = 0;
+
+            /**
+             * @brief The number of idle widget textures released to stay in the budget.
+             */
+            PiUInt64 evictions = 0;
+        };
+
         virtual ~ICacheToTexture() = default;
 
         virtual void Initialize() = 0;
@@ -44,16 +88,200 @@ namespace SparkyStudios::UI::Pixel
         virtual void SetupCacheTexture(CacheHandle widget) = 0;
         virtual void FinishCacheTexture(CacheHandle widget) = 0;
         virtual void DrawCachedWidgetTexture(CacheHandle widget) = 0;
-        virtual void CreateWidgetCacheTexture(CacheHandle widget, const Size& size) = 0;
+
+        /**
+         * @brief Ensures the widget owns a cache texture large enough for the given size.
+         *
+         * @return Whether the widget has a cache texture. This fails when the texture
+         * doesn't fit in the memory budget, the widget should then be rendered directly.
+         */
+        virtual bool CreateWidgetCacheTexture(CacheHandle widget, const Size& size) = 0;
+
+        /**
+         * @brief Releases the cache texture of the widget, if any.
+         */
+        virtual void FreeWidgetCacheTexture(CacheHandle widget) = 0;
+
+        /**
+         * @brief Checks if the cache texture of the widget holds rendered content.
+         *
+         * This is false for new textures, until they have been rendered once.
+         */
+        [[nodiscard]] virtual bool IsWidgetCacheTextureValid(CacheHandle widget) const = 0;
+
         virtual void UpdateWidgetCacheTexture(CacheHandle widget) = 0;
         virtual void SetRenderer(BaseRenderer* renderer) = 0;
+
+        /**
+         * @brief Sets the maximum memory the cache textures may use, in bytes.
+         */
+        virtual void SetBudget(PiUInt64 bytes) = 0;
+
+        [[nodiscard]] virtual PiUInt64 GetBudget() const = 0;
+
+        [[nodiscard]] virtual Stats GetStats() const = 0;
     };
 
+    class DisplayListRecorder;
+
     /**
      * @brief Base class for platform specific renderer implementations.
      */
     class PI_EXPORT BaseRenderer : public IResourceLoader
     {
+    public:
+        /**
+         * @brief Statistics about the draw operations processed during a frame.
+         *
+         * Those values are reset at the beginning of each frame.
+         */
+        struct FrameStats
+        {
+            /**
+             * @brief The number of primitives requested by widgets.
+             */
+            PiUInt32 primitives = 0;
+
+            /**
+             * @brief The number of draw calls submitted to the backend.
+             */
+            PiUInt32 drawCalls = 0;
+
+            /**
+             * @brief The number of times pending draw operations have been flushed.
+             */
+            PiUInt32 flushes = 0;
+
+            /**
+             * @brief The number of render states (clip rectangle, draw color) sent to the backend.
+             */
+            PiUInt32 stateChanges = 0;
+
+            /**
+             * @brief The number of render state changes skipped because the state was already set.
+             */
+            PiUInt32 elidedStateChanges = 0;
+
+            /**
+             * @brief The number of widgets skipped because an opaque sibling drawn after them covers them entirely.
+             */
+            PiUInt32 culledWidgets = 0;
+        };
+
+        /**
+         * @brief Occupancy statistics of the texture atlas pages.
+         */
+        struct TextureAtlasStats
+        {
+            /**
+             * @brief The number of atlas pages.
+             */
+            PiUInt32 pages = 0;
+
+            /**
+             * @brief The number of textures packed in the atlas pages.
+             */
+            PiUInt32 textures = 0;
+
+            /**
+             * @brief The area of the atlas pages covered by packed textures, in pixels.
+             */
+            PiUInt64 usedArea = 0;
+
+            /**
+             * @brief The total area of the atlas pages, in pixels.
+             */
+            PiUInt64 totalArea = 0;
+        };
+
+        /**
+         * @brief Usage statistics of the cache of tessellated shapes.
+         */
+        struct ShapeCacheStats
+        {
+            /**
+             * @brief The number of shapes found in the cache.
+             */
+            PiUInt64 hits = 0;
+
+            /**
+             * @brief The number of shapes tessellated because they were not in the cache.
+             */
+            PiUInt64 misses = 0;
+
+            /**
+             * @brief The number of shapes evicted to respect the cache capacity.
+             */
+            PiUInt64 evictions = 0;
+
+            /**
+             * @brief The number of shapes currently cached.
+             */
+            PiUInt32 shapes = 0;
+        };
+
+        /**
+         * @brief Occupancy statistics of the cache of loaded textures.
+         */
+        struct TextureCacheStats
+        {
+            /**
+             * @brief The number of loaded textures.
+             */
+            PiUInt32 textures = 0;
+
+            /**
+             * @brief The number of loaded textures holding at least one reference.
+             */
+            PiUInt32 referencedTextures = 0;
+
+            /**
+             * @brief The memory used by the loaded textures, in bytes.
+             */
+            PiUInt64 usedBytes = 0;
+
+            /**
+             * @brief The memory budget of the cache, in bytes.
+             */
+            PiUInt64 budget = 0;
+
+            /**
+             * @brief The number of unreferenced textures evicted to respect the budget.
+             */
+            PiUInt64 evictions = 0;
+        };
+
+        /**
+         * @brief The time spent loading a preloaded resource.
+         */
+        struct PreloadTiming
+        {
+            /**
+             * @brief The type of the resource, either a font or a texture.
+             */
+            ResourcePaths::Type type = ResourcePaths::Type::Other;
+
+            /**
+             * @brief The name of the resource. Font names include their size.
+             */
+            PiString name;
+
+            /**
+             * @brief The load status of the resource.
+             */
+            IResourceLoader::LoadStatus status = IResourceLoader::LoadStatus::Unloaded;
+
+            /**
+             * @brief The time spent reading and decoding the resource, in seconds.
+             */
+            PiTime decodeTime = 0;
+
+            /**
+             * @brief The time spent uploading the resource to the GPU, in seconds.
+             */
+            PiTime uploadTime = 0;
+        };
+
     protected:
         /**
          * @brief Constructor
@@ -85,6 +313,147 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual void End();
 
+        /**
+         * @brief Submits every pending draw operation to the backend.
+         *
+         * Renderers which defer draw operations should call this method
+         * before any change which affects how those operations are drawn.
+         */
+        virtual void Flush();
+
+        /**
+         * @brief Sets whether draw operations can be batched.
+         *
+         * When disabled, every draw operation is submitted immediately
+         * to the backend.
+         *
+         * @param enabled Whether draw operations can be batched.
+         */
+        void SetBatchingEnabled(bool enabled);
+
+        /**
+         * @brief Checks if draw operations can be batched.
+         *
+         * @return Whether draw operations can be batched.
+         */
+        [[nodiscard]] bool IsBatchingEnabled() const;
+
+        /**
+         * @brief Sets whether widgets record their draw operations into display lists.
+         *
+         * When enabled, widgets replay their display list instead of rendering
+         * again, until they are invalidated or redrawn. Disabled by default.
+         *
+         * @param enabled Whether widgets use display lists.
+         */
+        void SetDisplayListsEnabled(bool enabled);
+
+        /**
+         * @brief Checks if widgets record their draw operations into display lists.
+         *
+         * @return Whether widgets use display lists.
+         */
+        [[nodiscard]] bool IsDisplayListsEnabled() const;
+
+        /**
+         * @brief Gets the renderer used to record the display lists of widgets.
+         *
+         * @return The display list recorder, or nullptr when display lists are disabled.
+         */
+        DisplayListRecorder* GetDisplayListRecorder();
+
+        /**
+         * @brief Gets the statistics of the current frame.
+         *
+         * @return The frame statistics.
+         */
+        [[nodiscard]] const FrameStats& GetFrameStats() const;
+
+        /**
+         * @brief Counts widgets skipped by occlusion culling in the current frame statistics.
+         *
+         * @param count The number of skipped widgets.
+         */
+        void AddCulledWidgets(PiUInt32 count);
+
+        /**
+         * @brief Gets the occupancy statistics of the texture atlas.
+         *
+         * @return The atlas statistics. Renderers which don't pack textures in an atlas return empty statistics.
+         */
+        [[nodiscard]] virtual TextureAtlasStats GetTextureAtlasStats() const;
+
+        /**
+         * @brief Gets the usage statistics of the cache of tessellated shapes.
+         *
+         * @return The cache statistics. Renderers which don't cache shapes return empty statistics.
+         */
+        [[nodiscard]] virtual ShapeCacheStats GetShapeCacheStats() const;
+
+        /**
+         * @brief Sets the memory budget of the loaded textures.
+         *
+         * When the budget is exceeded, the least recently used unreferenced textures
+         * are freed. Referenced textures and textures drawn in the current frame are
+         * never evicted, so the budget may be exceeded temporarily.
+         *
+         * @param bytes The memory budget, in bytes.
+         */
+        virtual void SetTextureBudget(PiUInt64 bytes);
+
+        /**
+         * @brief Gets the memory budget of the loaded textures.
+         *
+         * @return The memory budget, in bytes. Renderers without a texture cache return 0.
+         */
+        [[nodiscard]] virtual PiUInt64 GetTextureBudget() const;
+
+        /**
+         * @brief Gets the occupancy statistics of the cache of loaded textures.
+         *
+         * @return The cache statistics. Renderers without a texture cache return empty statistics.
+         */
+        [[nodiscard]] virtual TextureCacheStats GetTextureCacheStats() const;
+
+        /**
+         * @brief Sets the directory where decoded textures are cached.
+         *
+         * Decoded pixels are stored on disk the first time a texture is loaded, and
+         * read back on the next loads instead of decoding the image file again. Cache
+         * files are invalidated when the image file changes.
+         *
+         * @param directory The cache directory. An empty directory disables the cache, which is the default.
+         */
+        virtual void SetTextureDiskCacheDirectory(const PiString& directory);
+
+        /**
+         * @brief Gets the directory where decoded textures are cached.
+         *
+         * @return The cache directory, empty when the cache is disabled or not supported by this renderer.
+         */
+        [[nodiscard]] virtual PiString GetTextureDiskCacheDirectory() const;
+
+        /**
+         * @brief Loads fonts and textures ahead of their first use.
+         *
+         * Renderers may decode the resources in parallel, then upload them on the calling
+         * thread, and skip the resources already loaded. The default implementation loads
+         * the resources one after the other.
+         *
+         * @param fonts The fonts to load.
+         * @param textures The textures to load.
+         *
+         * @return The time spent loading each resource.
+         */
+        virtual std::vector<PreloadTiming> Preload(const std::vector<Font>& fonts, const std::vector<Texture>& textures);
+
+        /**
+         * @brief Gets the cache of text measurements made by this renderer.
+         *
+         * @return The text measure cache.
+         */
+        TextMeasureCache& GetTextMeasureCache();
+
         /**
          * @brief Gets the IResourceLoader object.
          *
@@ -131,6 +500,22 @@ namespace SparkyStudios::UI::Pixel
          */
         void AddClipRegion(Rect rect);
 
+        /**
+         * @brief Intersects the clip region with the given rectangle and applies it.
+         *
+         * The previous clip region is saved, and restored by the matching call
+         * to BaseRenderer::PopClip().
+         *
+         * @param rect The clip rectangle, relative to the current render offset.
+         */
+        void PushClip(const Rect& rect);
+
+        /**
+         * @brief Restores and applies the clip region saved by the last call to
+         * BaseRenderer::PushClip().
+         */
+        void PopClip();
+
         /**
          * @brief Check if the clip region is valid and visible.
          *
@@ -259,12 +644,15 @@ namespace SparkyStudios::UI::Pixel
          * @param font The font to use when computing the size.
          * @param text The text.
          *
-         * @return The size of the text in pixels.
+         * @return The size of the text in render space units (pixels divided by the UI scale).
          */
         virtual Size MeasureText(const Font& font, const PiString& text);
 
         /**
-         * @brief Converts a position in pixels to render space coordinates.
+         * @brief Converts a position relative to the current widget to render space coordinates.
+         *
+         * Only the render offset is applied. The UI scale is applied by the renderer
+         * backend, once per frame, as a transformation.
          *
          * @param x The x coordinate.
          * @param y The y coordinate.
@@ -272,7 +660,10 @@ namespace SparkyStudios::UI::Pixel
         void Translate(PiInt32& x, PiInt32& y);
 
         /**
-         * @brief Converts a rectangle in pixels to render space coordinates.
+         * @brief Converts a rectangle relative to the current widget to render space coordinates.
+         *
+         * Only the render offset is applied. The UI scale is applied by the renderer
+         * backend, once per frame, as a transformation.
          *
          * @param rect The rectangle.
          */
@@ -350,6 +741,18 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual bool BeginContext(MainWindow* window);
 
+        /**
+         * @brief Starts a rendering session which only updates the given
+         * region of the window. The content outside that region is kept
+         * from the previous frame.
+         *
+         * @param window The window which holds the rendering context.
+         * @param region The region to render, in canvas units.
+         *
+         * @return Whether the operation was successful.
+         */
+        virtual bool BeginContext(MainWindow* window, const Rect& region);
+
         /**
          * @brief Ends a rendering session.
          *
@@ -368,6 +771,27 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual bool PresentContext(MainWindow* window);
 
+        /**
+         * @brief Presents only the given region of the rendering context.
+         *
+         * @param window The window which holds the rendering context.
+         * @param region The region to present, in canvas units. Nothing is
+         * presented when the region is empty.
+         *
+         * @return Whether the operation was successful.
+         */
+        virtual bool PresentContext(MainWindow* window, const Rect& region);
+
+        /**
+         * @brief Checks if the rendering context of the given window keeps the
+         * content of the previous frame and can present only a region of it.
+         *
+         * @param window The window which holds the rendering context.
+         *
+         * @return Whether partial rendering is supported.
+         */
+        virtual bool CanPresentRegion(MainWindow* window);
+
         /**
          * @brief Gets the widgets texture cache.
          *
@@ -395,11 +819,17 @@ namespace SparkyStudios::UI::Pixel
         virtual bool EnsureTexture(const Texture& texture);
 
         PiReal32 m_scale;
+        FrameStats m_frameStats;
+        TextMeasureCache m_measureCache;
 
     private:
         ResourcePaths& _paths;
         Point _renderOffset;
         Rect _rectClipRegion;
+        std::vector<Rect> _clipStack;
+        bool _batchingEnabled;
+        bool _displayListsEnabled;
+        DisplayListRecorder* _displayListRecorder;
     };
 } // namespace SparkyStudios::UI::Pixel
 
@@ -0,0 +1,134 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_CACHEPOLICY_H
+#define PIXEL_UI_CACHEPOLICY_H
+
+#include <SparkyStudios/UI/Pixel/Config/Config.h>
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    class Widget;
+
+    /**
+     * @brief Rendering statistics of a widget and its children, collected
+     * between two evaluations of the cache policy.
+     */
+    struct WidgetRenderStats
+    {
+        /**
+         * @brief The number of frames in which the widget has been drawn,
+         * from its cache texture or not.
+         */
+        PiUInt32 frames = 0;
+
+        /**
+         * @brief The number of frames in which the widget and its children have been rendered.
+         */
+        PiUInt32 renders = 0;
+
+        /**
+         * @brief The number of frames in which the widget or one of its children has changed.
+         */
+        PiUInt32 changes = 0;
+
+        /**
+         * @brief The number of primitives drawn while rendering the widget and its children.
+         */
+        PiUInt64 primitives = 0;
+    };
+
+    /**
+     * @brief Decides which widgets the canvas renders through a cache texture.
+     *
+     * The canvas periodically gives each visible widget's rendering statistics
+     * to the policy, which can enable or disable the cache to texture optimization
+     * on that widget. Widgets on which EnableCacheToTexture() has been called
+     * explicitly are left untouched.
+     */
+    class PI_EXPORT ICachePolicy
+    {
+    public:
+        enum class Decision
+        {
+            /**
+             * @brief Leave the widget as it is.
+             */
+            Keep,
+
+            /**
+             * @brief Render the widget through a cache texture.
+             */
+            Cache,
+
+            /**
+             * @brief Render the widget directly.
+             */
+            Uncache,
+        };
+
+        virtual ~ICachePolicy() = default;
+
+        /**
+         * @brief Gets the number of rendered frames between two evaluations.
+         */
+        [[nodiscard]] virtual PiUInt32 GetEvaluationInterval() const = 0;
+
+        /**
+         * @brief Checks if the given widget may be cached.
+         */
+        [[nodiscard]] virtual bool IsCandidate(const Widget* widget) const = 0;
+
+        /**
+         * @brief Decides if the given widget should be cached.
+         *
+         * @param widget The widget to evaluate.
+         * @param stats The rendering statistics of the widget since the last evaluation.
+         * @param cached Whether the widget is currently cached by the policy.
+         */
+        virtual Decision Evaluate(const Widget* widget, const WidgetRenderStats& stats, bool cached) = 0;
+    };
+
+    /**
+     * @brief Caches widgets which are expensive to render and rarely change.
+     */
+    class PI_EXPORT DefaultCachePolicy : public ICachePolicy
+    {
+    public:
+        /**
+         * @brief Creates a new cache policy.
+         *
+         * @param interval The number of rendered frames between two evaluations.
+         * @param minPrimitives The average number of primitives from which a widget is worth caching.
+         * @param maxChangeRate The ratio of frames in which a cached widget may change.
+         */
+        explicit DefaultCachePolicy(PiUInt32 interval = 60, PiUInt32 minPrimitives = 32, PiReal32 maxChangeRate = 0.1f);
+
+        [[nodiscard]] PiUInt32 GetEvaluationInterval() const override;
+
+        [[nodiscard]] bool IsCandidate(const Widget* widget) const override;
+
+        Decision Evaluate(const Widget* widget, const WidgetRenderStats& stats, bool cached) override;
+
+    private:
+        PiUInt32 _interval;
+        PiUInt32 _minPrimitives;
+        PiReal32 _maxChangeRate;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_CACHEPOLICY_H
@@ -0,0 +1,203 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_DISPLAYLIST_H
+#define PIXEL_UI_DISPLAYLIST_H
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
+
+#include <mutex>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A list of draw operations which can be replayed into a renderer.
+     *
+     * Coordinates are kept as they have been given, so the list is replayed
+     * relative to the render offset and clip region of the renderer at replay time.
+     *
+     * Lists recorded over several widgets also hold the render offset and clip
+     * region changes. These are absolute, and the renderer state is restored
+     * at the end of the replay.
+     */
+    class PI_EXPORT DisplayList
+    {
+        friend class DisplayListRecorder;
+
+        enum class Operation : PiUInt8
+        {
+            SetRenderOffset,
+            SetClipRegion,
+            SetDrawColor,
+            DrawFilledRect,
+            DrawTexturedRect,
+            DrawLinedRect,
+            DrawPixel,
+            DrawFilledEllipse,
+            DrawLinedEllipse,
+            DrawFilledTriangle,
+            DrawLinedTriangle,
+            DrawShavedCornerRect,
+            DrawString,
+        };
+
+        struct Command
+        {
+            Operation operation;
+
+            // The line thickness, the slight flag, or the font or texture index.
+            PiUInt32 param = 0;
+
+            // The index of the text of DrawString.
+            PiUInt32 text = 0;
+
+            Rect rect;
+            Size radii;
+            Point points[3];
+            Color color;
+            PiReal32 uv[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+        };
+
+    public:
+        /**
+         * @brief Removes every recorded operation.
+         */
+        void Clear();
+
+        /**
+         * @brief Checks if the list holds no operation.
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+        /**
+         * @brief Gets the number of recorded operations.
+         */
+        [[nodiscard]] std::size_t GetCommandCount() const;
+
+        /**
+         * @brief Replays the recorded operations into the given renderer.
+         */
+        void Replay(BaseRenderer* renderer) const;
+
+    private:
+        Command& Add(Operation operation);
+
+        std::vector<Command> _commands;
+        std::vector<Font> _fonts;
+        std::vector<Texture> _textures;
+        std::vector<PiString> _texts;
+    };
+
+    /**
+     * @brief A renderer which records draw operations into a display list.
+     *
+     * Text measurements and resource management are answered by the target renderer.
+     * Render offset and clip region changes are recorded as well, so a whole
+     * widget tree can be recorded into a single list.
+     */
+    class PI_EXPORT DisplayListRecorder : public BaseRenderer
+    {
+    public:
+        /**
+         * @brief Creates a new display list recorder.
+         *
+         * @param paths The resource paths of the target renderer.
+         * @param target The renderer answering text measurements and resource requests.
+         */
+        DisplayListRecorder(ResourcePaths& paths, BaseRenderer* target);
+
+        /**
+         * @brief Sets the display list receiving the draw operations.
+         *
+         * @param list The display list, or nullptr to discard the draw operations.
+         */
+        void SetDisplayList(DisplayList* list);
+
+        /**
+         * @brief Sets the mutex locked while calling the target renderer.
+         *
+         * This allows several recorders to share a target renderer from different threads.
+         *
+         * @param mutex The mutex, or nullptr to call the target renderer directly.
+         */
+        void SetTargetMutex(std::mutex* mutex);
+
+        void SetDrawColor(const Color& color) override;
+
+        void StartClip() override;
+
+        Color PixelColor(const Texture& texture, const Point& position, const Color& defaultColor = Colors::White) override;
+
+        void DrawFilledRect(Rect rect, const Size& radii) override;
+
+        void DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2) override;
+
+        void DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii) override;
+
+        void DrawPixel(const Point& position) override;
+
+        void DrawFilledEllipse(Rect rect) override;
+
+        void DrawLinedEllipse(Rect rect, PiUInt32 thickness) override;
+
+        void DrawFilledTriangle(Point p1, Point p2, Point p3) override;
+
+        void DrawLinedTriangle(Point p1, Point p2, Point p3, PiUInt32 thickness) override;
+
+        void DrawShavedCornerRect(Rect rect, bool slight = false) override;
+
+        void DrawString(const Font& font, Point pos, const PiString& text) override;
+
+        Size MeasureText(const Font& font, const PiString& text) override;
+
+        LoadStatus LoadFont(const Font& font) override;
+
+        void FreeFont(const Font& font) override;
+
+        LoadStatus LoadTexture(const Texture& texture) override;
+
+        LoadStatus LoadTextureAsync(const Texture& texture) override;
+
+        LoadStatus GetTextureStatus(const Texture& texture) const override;
+
+        void FreeTexture(const Texture& texture) override;
+
+        LoadStatus AcquireTexture(const Texture& texture, bool async = false) override;
+
+        void ReleaseTexture(const Texture& texture) override;
+
+        TextureData GetTextureData(const Texture& texture) const override;
+
+    private:
+        /**
+         * @brief Records the render offset if it changed since the last recorded operation.
+         */
+        void RecordOffset();
+
+        /**
+         * @brief Locks the target mutex, if any.
+         */
+        [[nodiscard]] std::unique_lock<std::mutex> LockTarget() const;
+
+        BaseRenderer* _target;
+        std::mutex* _targetMutex;
+        DisplayList* _list;
+        Point _recordedOffset;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_DISPLAYLIST_H
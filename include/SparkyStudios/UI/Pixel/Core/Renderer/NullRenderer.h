@@ -0,0 +1,159 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_NULLRENDERER_H
+#define PIXEL_UI_NULLRENDERER_H
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A renderer which draws nothing and only counts the operations it receives.
+     *
+     * This renderer doesn't need a display, and reports deterministic font
+     * and texture metrics. It is meant to profile layout and widget rendering
+     * logic on headless machines.
+     */
+    class PI_EXPORT Renderer_Null : public BaseRenderer
+    {
+    public:
+        /**
+         * @brief The number of operations received by the renderer.
+         */
+        struct Counters
+        {
+            PiUInt64 frames = 0;
+            PiUInt64 setDrawColor = 0;
+            PiUInt64 startClip = 0;
+            PiUInt64 endClip = 0;
+            PiUInt64 filledRects = 0;
+            PiUInt64 texturedRects = 0;
+            PiUInt64 linedRects = 0;
+            PiUInt64 pixels = 0;
+            PiUInt64 filledEllipses = 0;
+            PiUInt64 linedEllipses = 0;
+            PiUInt64 filledTriangles = 0;
+            PiUInt64 linedTriangles = 0;
+            PiUInt64 shavedCornerRects = 0;
+            PiUInt64 strings = 0;
+            PiUInt64 measures = 0;
+            PiUInt64 fontLoads = 0;
+            PiUInt64 textureLoads = 0;
+
+            /**
+             * @brief Gets the total number of draw operations.
+             */
+            [[nodiscard]] PiUInt64 GetDrawCount() const;
+        };
+
+        explicit Renderer_Null(ResourcePaths& paths);
+        ~Renderer_Null() override = default;
+
+        /**
+         * @brief Gets the operation counters.
+         */
+        [[nodiscard]] const Counters& GetCounters() const;
+
+        /**
+         * @brief Resets every operation counter to zero.
+         */
+        void ResetCounters();
+
+        /**
+         * @brief Sets the size reported for every loaded texture.
+         *
+         * @param size The texture size, in pixels.
+         */
+        void SetTextureSize(const Size& size);
+
+        void Begin() override;
+
+        void SetDrawColor(const Color& color) override;
+
+        void StartClip() override;
+
+        void EndClip() override;
+
+        void DrawFilledRect(Rect rect, const Size& radii) override;
+
+        void DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2) override;
+
+        void DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii) override;
+
+        void DrawPixel(const Point& position) override;
+
+        void DrawFilledEllipse(Rect rect) override;
+
+        void DrawLinedEllipse(Rect rect, PiUInt32 thickness) override;
+
+        void DrawFilledTriangle(Point p1, Point p2, Point p3) override;
+
+        void DrawLinedTriangle(Point p1, Point p2, Point p3, PiUInt32 thickness) override;
+
+        void DrawShavedCornerRect(Rect rect, bool slight = false) override;
+
+        void DrawString(const Font& font, Point pos, const PiString& text) override;
+
+        /**
+         * @brief Measures the given text with fake metrics.
+         *
+         * Each UTF-8 code point advances by half the font size, and
+         * a line is 1.25 times the font size high.
+         */
+        Size MeasureText(const Font& font, const PiString& text) override;
+
+        bool InitializeContext(MainWindow* window) override;
+
+        bool DestroyContext(MainWindow* window) override;
+
+        bool ResizedContext(MainWindow* window, const Size& size) override;
+
+        bool BeginContext(MainWindow* window) override;
+
+        bool EndContext(MainWindow* window) override;
+
+        bool PresentContext(MainWindow* window) override;
+
+        LoadStatus LoadFont(const Font& font) override;
+
+        void FreeFont(const Font& font) override;
+
+        LoadStatus LoadTexture(const Texture& texture) override;
+
+        void FreeTexture(const Texture& texture) override;
+
+        TextureData GetTextureData(const Texture& texture) const override;
+
+    protected:
+        bool EnsureFont(const Font& font) override;
+
+        bool EnsureTexture(const Texture& texture) override;
+
+    private:
+        void CountDraw(PiUInt64& counter);
+
+        Counters _counters;
+        Size _textureSize;
+        std::unordered_set<Font> _fonts;
+        std::unordered_map<Texture, TextureData> _textures;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_NULLRENDERER_H
@@ -0,0 +1,241 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_RECORDINGRENDERER_H
+#define PIXEL_UI_RECORDINGRENDERER_H
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A renderer which records every draw operation into a compact binary stream.
+     *
+     * The recorder can wrap another renderer, in which case every operation
+     * is also forwarded to it. Resource loading and text measurements are
+     * always answered by the wrapped renderer when there is one.
+     *
+     * Recorded streams are self-contained and can be replayed into any
+     * renderer with a RecordingPlayer.
+     */
+    class PI_EXPORT RecordingRenderer : public BaseRenderer
+    {
+    public:
+        /**
+         * @brief Creates a new recording renderer.
+         *
+         * @param paths The resource paths used when there is no target renderer.
+         * @param target The renderer to forward operations to, or nullptr to only record them.
+         */
+        explicit RecordingRenderer(ResourcePaths& paths, BaseRenderer* target = nullptr);
+        ~RecordingRenderer() override = default;
+
+        /**
+         * @brief Sets the renderer to forward operations to.
+         *
+         * @param target The target renderer, or nullptr to only record operations.
+         */
+        void SetTarget(BaseRenderer* target);
+
+        /**
+         * @brief Gets the renderer operations are forwarded to.
+         */
+        [[nodiscard]] BaseRenderer* GetTarget() const;
+
+        /**
+         * @brief Sets whether the draw operations are recorded.
+         *
+         * @param recording Whether the draw operations are recorded.
+         */
+        void SetRecording(bool recording);
+
+        /**
+         * @brief Checks if the draw operations are recorded.
+         */
+        [[nodiscard]] bool IsRecording() const;
+
+        /**
+         * @brief Gets the recorded stream.
+         */
+        [[nodiscard]] const std::vector<PiUInt8>& GetStream() const;
+
+        /**
+         * @brief Gets the number of commands recorded in the stream.
+         */
+        [[nodiscard]] PiUInt32 GetCommandCount() const;
+
+        /**
+         * @brief Discards the recorded stream.
+         */
+        void Clear();
+
+        /**
+         * @brief Saves the recorded stream into a file.
+         *
+         * @param path The path of the file.
+         *
+         * @return Whether the file has been written.
+         */
+        bool SaveToFile(const PiString& path) const;
+
+        void Init() override;
+
+        void Begin() override;
+
+        void End() override;
+
+        void Flush() override;
+
+        void SetDrawColor(const Color& color) override;
+
+        void StartClip() override;
+
+        void EndClip() override;
+
+        Color PixelColor(const Texture& texture, const Point& position, const Color& defaultColor = Colors::White) override;
+
+        void DrawFilledRect(Rect rect, const Size& radii) override;
+
+        void DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2) override;
+
+        void DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii) override;
+
+        void DrawPixel(const Point& position) override;
+
+        void DrawFilledEllipse(Rect rect) override;
+
+        void DrawLinedEllipse(Rect rect, PiUInt32 thickness) override;
+
+        void DrawFilledTriangle(Point p1, Point p2, Point p3) override;
+
+        void DrawLinedTriangle(Point p1, Point p2, Point p3, PiUInt32 thickness) override;
+
+        void DrawShavedCornerRect(Rect rect, bool slight = false) override;
+
+        void DrawString(const Font& font, Point pos, const PiString& text) override;
+
+        Size MeasureText(const Font& font, const PiString& text) override;
+
+        bool InitializeContext(MainWindow* window) override;
+
+        bool DestroyContext(MainWindow* window) override;
+
+        bool ResizedContext(MainWindow* window, const Size& size) override;
+
+        bool BeginContext(MainWindow* window) override;
+
+        bool EndContext(MainWindow* window) override;
+
+        bool PresentContext(MainWindow* window) override;
+
+        LoadStatus LoadFont(const Font& font) override;
+
+        void FreeFont(const Font& font) override;
+
+        LoadStatus LoadTexture(const Texture& texture) override;
+
+        LoadStatus LoadTextureAsync(const Texture& texture) override;
+
+        LoadStatus GetTextureStatus(const Texture& texture) const override;
+
+        void FreeTexture(const Texture& texture) override;
+
+        LoadStatus AcquireTexture(const Texture& texture, bool async = false) override;
+
+        void ReleaseTexture(const Texture& texture) override;
+
+        TextureData GetTextureData(const Texture& texture) const override;
+
+    private:
+        /**
+         * @brief Records the renderer state which changed since the last recorded command.
+         */
+        void RecordState();
+
+        /**
+         * @brief Copies the renderer state into the target renderer.
+         */
+        void SyncTarget();
+
+        PiUInt32 InternFont(const Font& font);
+        PiUInt32 InternTexture(const Texture& texture);
+
+        BaseRenderer* _target;
+        bool _recording;
+        PiUInt32 _commandCount;
+        std::vector<PiUInt8> _stream;
+        std::unordered_map<Font, PiUInt32> _fontIds;
+        std::unordered_map<Texture, PiUInt32> _textureIds;
+
+        bool _stateRecorded;
+        Point _recordedOffset;
+        Rect _recordedClip;
+        PiReal32 _recordedScale;
+    };
+
+    /**
+     * @brief Replays streams recorded by a RecordingRenderer into another renderer.
+     */
+    class PI_EXPORT RecordingPlayer
+    {
+    public:
+        /**
+         * @brief Creates a new recording player.
+         *
+         * @param target The renderer into which streams are replayed.
+         */
+        explicit RecordingPlayer(BaseRenderer* target);
+
+        /**
+         * @brief Replays a recorded stream.
+         *
+         * @param stream The recorded stream.
+         *
+         * @return Whether the whole stream has been replayed. Replay stops at the first malformed command.
+         */
+        bool Play(const std::vector<PiUInt8>& stream);
+
+        /**
+         * @brief Replays a recorded stream.
+         *
+         * @param data The recorded stream data.
+         * @param size The size of the recorded stream, in bytes.
+         *
+         * @return Whether the whole stream has been replayed. Replay stops at the first malformed command.
+         */
+        bool Play(const PiUInt8* data, std::size_t size);
+
+        /**
+         * @brief Loads a stream saved with RecordingRenderer::SaveToFile().
+         *
+         * @param path The path of the file.
+         * @param stream The loaded stream.
+         *
+         * @return Whether the file has been loaded.
+         */
+        static bool LoadFromFile(const PiString& path, std::vector<PiUInt8>& stream);
+
+    private:
+        BaseRenderer* _target;
+        std::vector<Font> _fonts;
+        std::vector<Texture> _textures;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_RECORDINGRENDERER_H
@@ -21,6 +21,8 @@
 
 #include <SparkyStudios/UI/Pixel/Widgets/Base.h>
 
+#include <vector>
+
 namespace SparkyStudios::UI::Pixel
 {
     class Widget;
@@ -344,6 +346,16 @@ namespace SparkyStudios::UI::Pixel
                 Color textColorFocused;
                 PiUInt32 textSize;
             } Input;
+
+            // Preload
+            struct
+            {
+                // Fonts loaded when the application is initialized
+                std::vector<Font> fonts;
+
+                // Textures loaded when the application is initialized
+                std::vector<PiString> textures;
+            } Preload;
         };
 
         /**
@@ -679,6 +691,12 @@ namespace SparkyStudios::UI::Pixel
             Color(255, 255, 255, 255), // Focused Text Color
             12, // Text Size
         },
+
+        // Preload
+        {
+            {}, // Fonts
+            {}, // Textures
+        },
     };
 } // namespace SparkyStudios::UI::Pixel
 
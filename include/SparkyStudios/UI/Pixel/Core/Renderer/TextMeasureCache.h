@@ -0,0 +1,167 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_TEXTMEASURECACHE_H
+#define PIXEL_UI_TEXTMEASURECACHE_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <SparkyStudios/UI/Pixel/Graphics/Point.h>
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Bounded cache of text measurements, with least recently used eviction.
+     *
+     * Measurements are keyed on a font handle provided by the renderer
+     * and on the hash of the measured text. The text itself is kept
+     * to discard hash collisions.
+     */
+    class PI_EXPORT TextMeasureCache
+    {
+    public:
+        /**
+         * @brief An opaque value identifying a loaded font in the renderer.
+         */
+        typedef std::uintptr_t FontHandle;
+
+        /**
+         * @brief Usage statistics of the cache.
+         */
+        struct Stats
+        {
+            /**
+             * @brief The number of measurements found in the cache.
+             */
+            PiUInt64 hits = 0;
+
+            /**
+             * @brief The number of measurements not found in the cache.
+             */
+            PiUInt64 misses = 0;
+
+            /**
+             * @brief The number of measurements evicted to respect the cache capacity.
+             */
+            PiUInt64 evictions = 0;
+        };
+
+        /**
+         * @brief Creates a new text measure cache.
+         *
+         * @param capacity The maximum number of measurements to keep.
+         */
+        explicit TextMeasureCache(std::size_t capacity = 4096);
+
+        /**
+         * @brief Finds a cached measurement.
+         *
+         * @param font The handle of the font used to measure the text.
+         * @param text The measured text.
+         * @param size The cached measurement, if found.
+         *
+         * @return Whether the measurement has been found.
+         */
+        bool Find(FontHandle font, const PiString& text, Size& size);
+
+        /**
+         * @brief Stores a measurement in the cache.
+         *
+         * @param font The handle of the font used to measure the text.
+         * @param text The measured text.
+         * @param size The measurement.
+         */
+        void Insert(FontHandle font, const PiString& text, const Size& size);
+
+        /**
+         * @brief Removes every measurement made with the given font.
+         *
+         * @param font The handle of the font.
+         */
+        void Invalidate(FontHandle font);
+
+        /**
+         * @brief Removes every measurement from the cache.
+         */
+        void Clear();
+
+        /**
+         * @brief Sets the maximum number of measurements to keep.
+         *
+         * @param capacity The maximum number of measurements.
+         */
+        void SetCapacity(std::size_t capacity);
+
+        /**
+         * @brief Gets the maximum number of measurements to keep.
+         */
+        [[nodiscard]] std::size_t GetCapacity() const;
+
+        /**
+         * @brief Gets the number of measurements currently cached.
+         */
+        [[nodiscard]] std::size_t GetSize() const;
+
+        /**
+         * @brief Gets the usage statistics of the cache.
+         */
+        [[nodiscard]] const Stats& GetStats() const;
+
+        /**
+         * @brief Resets the usage statistics of the cache.
+         */
+        void ResetStats();
+
+    private:
+        struct Key
+        {
+            FontHandle font;
+            std::size_t hash;
+
+            bool operator==(const Key& other) const
+            {
+                return font == other.font && hash == other.hash;
+            }
+        };
+
+        struct KeyHasher
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            Key key;
+            PiString text;
+            Size size;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        void Trim();
+
+        EntryList _entries;
+        std::unordered_map<Key, EntryList::iterator, KeyHasher> _index;
+        std::size_t _capacity;
+        Stats _stats;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_TEXTMEASURECACHE_H
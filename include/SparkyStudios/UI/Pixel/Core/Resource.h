@@ -69,6 +69,24 @@ namespace SparkyStudios::UI::Pixel
          * @return Path relative to the resource directory.
          */
         virtual PiString GetPath(Type type, const PiString& name) const = 0;
+
+        /**
+         * @brief Get the content of a resource already available in memory.
+         *
+         * Resource loaders read the resource from memory when available, and
+         * open the file at GetPath() otherwise.
+         *
+         * @param type File resource type.
+         * @param name Relative path to file.
+         * @param data Receives the content of the resource.
+         * @param size Receives the size of the resource, in bytes.
+         *
+         * @return Whether the resource is available in memory.
+         */
+        virtual bool GetData(Type type, const PiString& name, const void*& data, PiUInt64& size) const
+        {
+            return false;
+        }
     };
 
     /**
@@ -148,6 +166,11 @@ namespace SparkyStudios::UI::Pixel
              */
             ErrorBadData,
 
+            /**
+             * @brief The resource is being loaded asynchronously.
+             */
+            Pending,
+
             MAX
         };
 
@@ -174,6 +197,32 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual LoadStatus LoadTexture(const Texture& texture) = 0;
 
+        /**
+         * @brief Starts loading a texture resource without blocking the caller.
+         *
+         * The texture is reported as pending until it is ready to be drawn. Drawing
+         * a pending texture draws a placeholder instead. Loaders without asynchronous
+         * loading load the texture immediately.
+         *
+         * @param texture The texture resource to load.
+         * @return The load status, LoadStatus::Pending while the texture is loading.
+         */
+        virtual LoadStatus LoadTextureAsync(const Texture& texture)
+        {
+            return LoadTexture(texture);
+        }
+
+        /**
+         * @brief Gets the load status of a texture resource.
+         *
+         * @param texture The texture resource.
+         * @return The load status of the texture.
+         */
+        virtual LoadStatus GetTextureStatus(const Texture& texture) const
+        {
+            return GetTextureData(texture).width > 0 ? LoadStatus::Loaded : LoadStatus::Unloaded;
+        }
+
         /**
          * @brief Releases a texture resource.
          *
@@ -181,6 +230,35 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual void FreeTexture(const Texture& texture) = 0;
 
+        /**
+         * @brief Loads a texture resource, and holds a reference on it until it is released.
+         *
+         * Referenced textures are never evicted from the texture cache. Each call must be
+         * balanced by a call to ReleaseTexture(). Loaders without reference counting
+         * load the texture.
+         *
+         * @param texture The texture resource to acquire.
+         * @param async Whether to load the texture without blocking the caller.
+         * @return The load status.
+         */
+        virtual LoadStatus AcquireTexture(const Texture& texture, bool async = false)
+        {
+            return async ? LoadTextureAsync(texture) : LoadTexture(texture);
+        }
+
+        /**
+         * @brief Releases a reference acquired on a texture resource.
+         *
+         * Unreferenced textures stay cached until they are evicted to respect the
+         * memory budget. Loaders without reference counting free the texture.
+         *
+         * @param texture The texture resource to release.
+         */
+        virtual void ReleaseTexture(const Texture& texture)
+        {
+            FreeTexture(texture);
+        }
+
         /**
          * @brief Get the texture data from a texture resource.
          *
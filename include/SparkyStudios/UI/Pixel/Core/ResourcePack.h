@@ -0,0 +1,166 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_RESOURCEPACK_H
+#define PIXEL_UI_RESOURCEPACK_H
+
+#include <SparkyStudios/UI/Pixel/Core/Resource.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    class MappedFile;
+
+    /**
+     * @brief A single file bundling application resources, mapped in memory.
+     *
+     * The pack starts with a header and an index of the resources, followed by
+     * their content. All the values are stored in little endian:
+     *
+     * - the "PIPK" magic, the format version, the number of resources and a reserved word, as 32 bits integers,
+     * - for each resource, its type and the length of its name as 32 bits integers, the offset of its content
+     *   from the start of the file and its size as 64 bits integers, then its name,
+     * - the content of the resources.
+     */
+    class PI_EXPORT ResourcePack
+    {
+    public:
+        /**
+         * @brief The version of the pack format.
+         */
+        static constexpr PiUInt32 kVersion = 1;
+
+        /**
+         * @brief A file to bundle in a resource pack.
+         */
+        struct Source
+        {
+            /**
+             * @brief The type of the resource.
+             */
+            ResourcePaths::Type type;
+
+            /**
+             * @brief The name used to load the resource, eg. "fonts/OpenSans.ttf".
+             */
+            PiString name;
+
+            /**
+             * @brief The path of the file to read.
+             */
+            PiString path;
+        };
+
+        /**
+         * @brief Writes a resource pack.
+         *
+         * @param path The path of the pack file to write.
+         * @param sources The files to bundle.
+         *
+         * @return Whether the pack has been written.
+         */
+        static bool Write(const PiString& path, const std::vector<Source>& sources);
+
+        ResourcePack();
+        ~ResourcePack();
+
+        ResourcePack(const ResourcePack&) = delete;
+        ResourcePack& operator=(const ResourcePack&) = delete;
+
+        /**
+         * @brief Maps a resource pack in memory and reads its index.
+         *
+         * @param path The path of the pack file.
+         * @return Whether the pack is valid and has been mapped.
+         */
+        bool Open(const PiString& path);
+
+        /**
+         * @brief Unmaps the resource pack. The content of its resources is no longer available.
+         */
+        void Close();
+
+        /**
+         * @brief Checks if a resource pack is mapped.
+         */
+        [[nodiscard]] bool IsOpen() const;
+
+        /**
+         * @brief Gets the number of resources in the pack.
+         */
+        [[nodiscard]] PiUInt32 GetResourceCount() const;
+
+        /**
+         * @brief Finds the content of a resource in the pack.
+         *
+         * Font names are looked up with the ".ttf" extension, the same way as
+         * RelativeToExecutableResourcePaths does.
+         *
+         * @param type The resource type.
+         * @param name The resource name.
+         * @param data Receives the content of the resource, valid until the pack is closed.
+         * @param size Receives the size of the resource, in bytes.
+         *
+         * @return Whether the resource is in the pack.
+         */
+        bool Find(ResourcePaths::Type type, const PiString& name, const void*& data, PiUInt64& size) const;
+
+    private:
+        struct Range
+        {
+            PiUInt64 offset;
+            PiUInt64 size;
+        };
+
+        MappedFile* _file;
+        std::unordered_map<PiString, Range> _index[static_cast<std::size_t>(ResourcePaths::Type::MAX)];
+        PiUInt32 _count;
+    };
+
+    /**
+     * @brief Get application resources from a resource pack.
+     *
+     * Resources missing from the pack are loaded from the fallback resource paths, if any.
+     */
+    class PI_EXPORT ResourcePackPaths : public ResourcePaths
+    {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param packPath The path of the resource pack file.
+         * @param fallback Optional resource paths used for resources missing from the pack. Not owned.
+         */
+        explicit ResourcePackPaths(const PiString& packPath, const ResourcePaths* fallback = nullptr);
+
+        PiString GetPath(Type type, const PiString& name) const override;
+
+        bool GetData(Type type, const PiString& name, const void*& data, PiUInt64& size) const override;
+
+        /**
+         * @brief Gets the resource pack.
+         */
+        [[nodiscard]] const ResourcePack& GetPack() const;
+
+    private:
+        ResourcePack _pack;
+        const ResourcePaths* _fallback;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_RESOURCEPACK_H
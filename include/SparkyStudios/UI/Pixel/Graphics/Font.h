@@ -50,6 +50,7 @@ namespace SparkyStudios::UI::Pixel
             , size(size)
             , weight(weight)
             , style(style)
+            , handle(0)
         {}
 
         Font()
@@ -57,6 +58,7 @@ namespace SparkyStudios::UI::Pixel
             , size(10)
             , weight(Weight::Regular)
             , style(Style::Normal)
+            , handle(0)
         {}
 
         Font(const Font&) = default;
@@ -76,6 +78,10 @@ namespace SparkyStudios::UI::Pixel
         float size;
         Weight weight;
         Style style;
+
+        /// The handle interned by the renderer which last resolved this font, 0 until then.
+        /// Not part of the font identity, so it is ignored by comparisons and hashing.
+        mutable PiHandle handle;
     };
 } // namespace SparkyStudios::UI::Pixel
 
@@ -109,6 +109,46 @@ namespace SparkyStudios::UI::Pixel
             return Point(x, y);
         }
 
+        bool IsEmpty() const
+        {
+            return w <= 0 || h <= 0;
+        }
+
+        bool Contains(const Rect& rect) const
+        {
+            return rect.x >= x && rect.y >= y && rect.Right() <= Right() && rect.Bottom() <= Bottom();
+        }
+
+        Rect Intersect(const Rect& rect) const
+        {
+            const PiInt32 left = x > rect.x ? x : rect.x;
+            const PiInt32 top = y > rect.y ? y : rect.y;
+            const PiInt32 right = Right() < rect.Right() ? Right() : rect.Right();
+            const PiInt32 bottom = Bottom() < rect.Bottom() ? Bottom() : rect.Bottom();
+
+            if (right <= left || bottom <= top)
+                return Rect();
+
+            return Rect(left, top, right - left, bottom - top);
+        }
+
+        // Empty rectangles are ignored.
+        Rect Union(const Rect& rect) const
+        {
+            if (rect.IsEmpty())
+                return *this;
+
+            if (IsEmpty())
+                return rect;
+
+            const PiInt32 left = x < rect.x ? x : rect.x;
+            const PiInt32 top = y < rect.y ? y : rect.y;
+            const PiInt32 right = Right() > rect.Right() ? Right() : rect.Right();
+            const PiInt32 bottom = Bottom() > rect.Bottom() ? Bottom() : rect.Bottom();
+
+            return Rect(left, top, right - left, bottom - top);
+        }
+
         PiInt32 x, y, w, h;
     };
 } // namespace SparkyStudios::UI::Pixel
@@ -30,6 +30,7 @@ namespace SparkyStudios::UI::Pixel
 
         Texture()
             : readable(false)
+            , handle(0)
         {}
 
         Texture(const Texture&) = default;
@@ -46,6 +47,10 @@ namespace SparkyStudios::UI::Pixel
 
         PiString name;
         bool readable;
+
+        /// The handle interned by the renderer which last resolved this texture, 0 until then.
+        /// Not part of the texture identity, so it is ignored by comparisons and hashing.
+        mutable PiHandle handle;
     };
 
     struct TextureData
@@ -57,6 +57,7 @@ namespace SparkyStudios::UI::Pixel
         virtual void SetIsToggle(bool b)
         {
             m_bToggle = b;
+            Redraw();
         }
 
         virtual bool IsToggle() const
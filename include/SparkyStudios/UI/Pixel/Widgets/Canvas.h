@@ -17,7 +17,9 @@
 #ifndef PIXEL_UI_CANVAS_H
 #define PIXEL_UI_CANVAS_H
 
+#include <mutex>
 #include <set>
+#include <vector>
 
 #include <SparkyStudios/UI/Pixel/Core/Input/IInputEventListener.h>
 #include <SparkyStudios/UI/Pixel/Widgets/Containers/Menu.h>
@@ -26,6 +28,7 @@
 namespace SparkyStudios::UI::Pixel
 {
     class MainWindow;
+    class ThreadPool;
 
     class PI_EXPORT Canvas
         : public Widget
@@ -34,6 +37,11 @@ namespace SparkyStudios::UI::Pixel
         friend class Widget;
 
     public:
+        /// Called when the cache policy enables or disables the cache to texture
+        /// optimization on a widget. The event source is that widget, and the
+        /// boolean data tells whether it is now cached.
+        static const PiString CachePolicyEvent;
+
         PI_WIDGET(Canvas, Widget);
 
         class PI_EXPORT Input
@@ -78,6 +86,9 @@ namespace SparkyStudios::UI::Pixel
             static bool OnMouseButton(Widget* canvas, MouseButton mouseButton, MouseButtonPressMode mode);
             static bool OnKey(Widget* canvas, Key key, KeyPressMode mode);
             static void OnCanvasThink(Widget* widget);
+
+            // Time at which the next simulated key repeat is due, or infinity
+            static PiTime GetNextKeyRepeatTime();
         };
 
         static void UpdateHoveredControl(Widget* widget);
@@ -99,6 +110,10 @@ namespace SparkyStudios::UI::Pixel
         static void RenderTooltip(Skin* skin);
 
         explicit Canvas(MainWindow* window, Skin* skin = nullptr);
+
+        /// Creates a canvas which is not attached to any window, eg. to
+        /// render it offscreen or with a headless renderer.
+        explicit Canvas(const Size& size, Skin* skin = nullptr);
         ~Canvas() override;
 
         /// For additional initialization
@@ -106,6 +121,11 @@ namespace SparkyStudios::UI::Pixel
         virtual void Initialize()
         {}
 
+        /// Processes input, updates the layout and computes the region
+        /// to render in the next frame. RenderCanvas() calls this when it
+        /// has not been called since the previous frame.
+        virtual void PrepareRender();
+
         /// You should call this to render your canvas.
         virtual void RenderCanvas();
 
@@ -122,13 +142,51 @@ namespace SparkyStudios::UI::Pixel
             return m_needsRedraw;
         }
 
-        void Redraw() override
+        void Redraw() override;
+
+        /// When enabled, RenderCanvas() only renders the regions damaged since
+        /// the previous frame, and expects the renderer to preserve the rest
+        /// of the frame. Disabled by default.
+        void SetDirtyRectsEnabled(bool enabled);
+
+        bool IsDirtyRectsEnabled() const
+        {
+            return m_dirtyRectsEnabled;
+        }
+
+        /// Marks a region of the canvas as needing to be redrawn.
+        void AddDirtyRect(const Rect& rect);
+
+        /// The union of the regions damaged since the last frame.
+        const Rect& GetDirtyRect() const
         {
-            m_needsRedraw = true;
+            return m_dirtyRect;
         }
 
-        // Internal. Do not call directly.
-        void Render(Skin* render) override;
+        /// The region rendered by the last call to RenderCanvas().
+        const Rect& GetRenderedRect() const
+        {
+            return m_renderedRect;
+        }
+
+        /// Sets the policy deciding which widgets are cached to textures.
+        /// The canvas doesn't own the policy. Pass nullptr to disable
+        /// automatic caching, which is the default.
+        void SetCachePolicy(ICachePolicy* policy);
+
+        ICachePolicy* GetCachePolicy() const
+        {
+            return m_cachePolicy;
+        }
+
+        /// Renders the top level widgets on the given number of worker threads.
+        /// Each worker records the draw operations of a widget and its children
+        /// into a list, and the lists are replayed in order on the calling thread.
+        /// Widgets with their own skin or cached to a texture, and their parents,
+        /// are rendered on the calling thread. Pass 0 to disable, which is the default.
+        void SetRenderWorkerCount(PiUInt32 count);
+
+        PiUInt32 GetRenderWorkerCount() const;
 
         /// Child panels call parent->GetCanvas() until they get to
         /// this top level function.
@@ -189,16 +247,31 @@ namespace SparkyStudios::UI::Pixel
         virtual void SetBackgroundColor(const Color& color)
         {
             m_backgroundColor = color;
+            Redraw();
         }
 
         virtual void SetDrawBackground(bool shouldDraw)
         {
             m_drawBackground = shouldDraw;
+            Redraw();
         }
 
     protected:
         void PreDeleteCanvas(Widget* widget);
 
+        /// Evaluates the cache policy on the children of the given widget,
+        /// and resets their rendering statistics.
+        void ApplyCachePolicy(Widget* parent, bool insideCache);
+
+        static bool HasManuallyCachedChildren(const Widget* widget);
+
+        void RenderChildren(Skin* skin) override;
+
+        bool IsOpaque() const override;
+
+        /// Checks if the given widget and its children can be rendered on a worker thread.
+        static bool CanRenderInParallel(const Widget* widget);
+
         bool m_needsRedraw;
         bool m_anyDelete;
         float m_scale;
@@ -207,6 +280,22 @@ namespace SparkyStudios::UI::Pixel
         std::set<Widget*> m_deleteSet;
 
         Color m_backgroundColor;
+
+        bool m_dirtyRectsEnabled = false;
+        Rect m_dirtyRect;
+        Rect m_renderedRect;
+        bool m_renderPrepared = false;
+
+        ICachePolicy* m_cachePolicy = nullptr;
+        PiUInt32 m_cachePolicyFrames = 0;
+
+        struct RenderJob;
+
+        ThreadPool* m_renderWorkers = nullptr;
+        std::vector<RenderJob*> m_renderJobs;
+        PiUInt32 m_renderSkinVersion = 0;
+        std::mutex m_renderMutex;
+        std::mutex m_dirtyRectMutex;
     };
 } // namespace SparkyStudios::UI::Pixel
 
@@ -43,6 +43,8 @@ namespace SparkyStudios::UI::Pixel
 
         void SetDisableIconMargin(bool value);
 
+        Rect GetDrawBounds() const override;
+
     protected:
         void OnHoverItem(EventInfo info);
         virtual void OnAddItem(EventInfo info);
@@ -51,6 +53,13 @@ namespace SparkyStudios::UI::Pixel
         void Render(Skin* skin) override;
         void RenderUnder(Skin* skin) override;
 
+        bool IsOpaque() const override;
+
+        /**
+         * @brief Gets the background color of the menu in its current state.
+         */
+        [[nodiscard]] virtual Color GetBackgroundColor(const Skin::Data& skinData) const;
+
         void Layout(Skin* skin) override;
 
         bool IsMenuWidget() const override;
@@ -35,6 +35,10 @@ namespace SparkyStudios::UI::Pixel
         void Render(Skin* skin) override;
         void RenderUnder(Skin* skin) override;
 
+        bool IsOpaque() const override;
+
+        Color GetBackgroundColor(const Skin::Data& skinData) const override;
+
         void Layout(Skin* skin) override;
     };
 } // namespace SparkyStudios::UI::Pixel
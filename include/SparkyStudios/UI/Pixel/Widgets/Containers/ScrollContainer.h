@@ -61,6 +61,8 @@ namespace SparkyStudios::UI::Pixel
 
         void Render(Skin* skin) override;
 
+        bool IsOpaque() const override;
+
         bool m_scrollH;
         bool m_scrollV;
         bool m_autoHideScrollbars;
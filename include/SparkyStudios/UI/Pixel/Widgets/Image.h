@@ -24,6 +24,14 @@ namespace SparkyStudios::UI::Pixel
     class PI_EXPORT Image : public Widget
     {
     public:
+        /**
+         * @brief The image loaded event.
+         *
+         * This event is triggered when an image loaded asynchronously is ready
+         * to be drawn, or has failed to load.
+         */
+        static constexpr const char* const LoadedEvent = "Image::Events::Loaded";
+
         PI_WIDGET_INLINE(Image, Widget)
         {
             SetUV(0, 0, 1, 1);
@@ -32,11 +40,13 @@ namespace SparkyStudios::UI::Pixel
             SetStretch(true);
             m_texWidth = 0.0f;
             m_texHeight = 0.0f;
+            m_status = IResourceLoader::LoadStatus::Unloaded;
         }
 
         virtual ~Image()
         {
-            GetSkin()->GetRenderer()->GetLoader().FreeTexture(m_texture);
+            if (!m_texture.name.empty())
+                GetSkin()->GetRenderer()->GetLoader().ReleaseTexture(m_texture);
         }
 
         virtual void SetUV(float u1, float v1, float u2, float v2)
@@ -45,24 +55,34 @@ namespace SparkyStudios::UI::Pixel
             m_uv[1] = v1;
             m_uv[2] = u2;
             m_uv[3] = v2;
+            Redraw();
         }
 
-        virtual void SetImage(const PiString& imageName)
+        /**
+         * @brief Sets the image to display.
+         *
+         * @param imageName The name of the image texture.
+         * @param async Whether to load the texture without blocking. A placeholder is drawn
+         * until the texture is ready, then the Image::LoadedEvent event is triggered.
+         */
+        virtual void SetImage(const PiString& imageName, bool async = false)
         {
-            m_texture.name = imageName;
             IResourceLoader& loader = GetSkin()->GetRenderer()->GetLoader();
-            m_status = loader.LoadTexture(m_texture);
-            switch (m_status)
-            {
-            case IResourceLoader::LoadStatus::Loaded:
-                {
-                    TextureData texData = loader.GetTextureData(m_texture);
-                    m_texWidth = texData.width;
-                    m_texHeight = texData.height;
-                    break;
-                }
-            default:;
-            }
+
+            // Acquire the new texture first, so that it isn't evicted when it was already displayed.
+            const Texture previous = m_texture;
+            m_texture.name = imageName;
+            m_status = loader.AcquireTexture(m_texture, async);
+
+            if (!previous.name.empty())
+                loader.ReleaseTexture(previous);
+
+            // Poll the loader on each layout until the texture is ready.
+            if (m_status == IResourceLoader::LoadStatus::Pending)
+                Invalidate();
+
+            UpdateTextureSize(loader);
+            Redraw();
         }
 
         virtual const PiString& GetImage() const
@@ -89,6 +109,12 @@ namespace SparkyStudios::UI::Pixel
         {
             BaseRenderer* renderer = skin->GetRenderer();
 
+            if (m_status == IResourceLoader::LoadStatus::Pending)
+            {
+                renderer->DrawMissingImage(RenderBounds());
+                return;
+            }
+
             renderer->SetDrawColor(m_drawColor);
 
             if (m_bStretch)
@@ -108,12 +134,21 @@ namespace SparkyStudios::UI::Pixel
 
         virtual void SetDrawColor(Color color)
         {
+            if (m_drawColor == color)
+                return;
+
             m_drawColor = color;
+            Redraw();
         }
 
         virtual bool FailedToLoad()
         {
-            return m_status != IResourceLoader::LoadStatus::Loaded;
+            return m_status != IResourceLoader::LoadStatus::Loaded && m_status != IResourceLoader::LoadStatus::Pending;
+        }
+
+        virtual bool IsLoading() const
+        {
+            return m_status == IResourceLoader::LoadStatus::Pending;
         }
 
         virtual bool GetStretch()
@@ -124,9 +159,43 @@ namespace SparkyStudios::UI::Pixel
         virtual void SetStretch(bool b)
         {
             m_bStretch = b;
+            Redraw();
         }
 
     protected:
+        void Layout(Skin* skin) override
+        {
+            ParentClass::Layout(skin);
+
+            if (m_status != IResourceLoader::LoadStatus::Pending)
+                return;
+
+            IResourceLoader& loader = skin->GetRenderer()->GetLoader();
+            m_status = loader.GetTextureStatus(m_texture);
+
+            // The texture is uploaded when a frame begins, so keep requesting frames.
+            if (m_status == IResourceLoader::LoadStatus::Pending)
+            {
+                Invalidate();
+                return;
+            }
+
+            UpdateTextureSize(loader);
+            Redraw();
+
+            On(LoadedEvent)->Call(this);
+        }
+
+        void UpdateTextureSize(IResourceLoader& loader)
+        {
+            if (m_status != IResourceLoader::LoadStatus::Loaded)
+                return;
+
+            TextureData texData = loader.GetTextureData(m_texture);
+            m_texWidth = texData.width;
+            m_texHeight = texData.height;
+        }
+
         Texture m_texture;
         float m_uv[4];
         Color m_drawColor;
@@ -55,6 +55,13 @@ namespace SparkyStudios::UI::Pixel
 
     protected:
         void Render(Skin* skin) override;
+
+        bool IsOpaque() const override;
+
+        /**
+         * @brief Gets the background color of the status bar in its current state.
+         */
+        [[nodiscard]] Color GetBackgroundColor(const Skin::Data& skinData) const;
     };
 } // namespace SparkyStudios::UI::Pixel
 
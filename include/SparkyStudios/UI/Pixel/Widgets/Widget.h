@@ -19,10 +19,13 @@
 
 #include <list>
 #include <type_traits>
+#include <vector>
 
 #include <SparkyStudios/UI/Pixel/Core/Events/EventHandler.h>
 #include <SparkyStudios/UI/Pixel/Core/Events/EventListener.h>
 #include <SparkyStudios/UI/Pixel/Core/Input/IInputEventListener.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/CachePolicy.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
 #include <SparkyStudios/UI/Pixel/Core/Renderer/Skin.h>
 #include <SparkyStudios/UI/Pixel/Core/Utility.h>
 
@@ -111,6 +114,7 @@ namespace SparkyStudios::UI::Pixel
     class PI_EXPORT Widget : public EventHandler
     {
         friend class Canvas;
+        friend class Animation;
 
     public:
         /**
@@ -790,6 +794,11 @@ namespace SparkyStudios::UI::Pixel
          */
         [[nodiscard]] virtual bool IsCachedToTextureEnabled() const;
 
+        /**
+         * @brief Gets the rendering statistics collected since the last evaluation of the canvas cache policy.
+         */
+        [[nodiscard]] const WidgetRenderStats& GetRenderStats() const;
+
         /**
          * @brief Checks if this widget needs a layout pass.
          */
@@ -1066,6 +1075,23 @@ namespace SparkyStudios::UI::Pixel
          */
         void RenderRecursive(Skin* skin);
 
+        /**
+         * @brief Renders the visible children of this widget, in order.
+         *
+         * @param skin The skin to apply during the render.
+         */
+        virtual void RenderChildren(Skin* skin);
+
+        /**
+         * @brief Finds the children entirely covered by an opaque sibling drawn after them.
+         *
+         * The opaque siblings are gathered once, walking the children from the last one.
+         *
+         * @param occluded Set to whether each child of the children list is occluded, or left
+         * empty when none is.
+         */
+        void FindOccludedChildren(std::vector<bool>& occluded) const;
+
         /**
          * @brief Renders this widget on screen.
          *
@@ -1103,6 +1129,30 @@ namespace SparkyStudios::UI::Pixel
          */
         virtual void Redraw();
 
+        /**
+         * @brief Gets the area in which this widget draws, relative to this widget.
+         *
+         * Widgets drawing outside of their render bounds (eg. shadows) should
+         * override this, so that their whole area is redrawn when they change.
+         */
+        [[nodiscard]] virtual Rect GetDrawBounds() const;
+
+        /**
+         * @brief Checks if this widget covers its whole render bounds with opaque pixels.
+         *
+         * Siblings drawn before an opaque widget and entirely covered by it are not
+         * rendered. Widgets filling their bounds with an opaque background should
+         * override this.
+         */
+        [[nodiscard]] virtual bool IsOpaque() const;
+
+        /**
+         * @brief Marks a region of the canvas as needing to be redrawn.
+         *
+         * @param region The region to redraw, relative to this widget.
+         */
+        void AddDirtyRegion(const Rect& region);
+
         /**
          * @brief Updates the widget layout and texture cache
          * if enabled.
@@ -1241,6 +1291,26 @@ namespace SparkyStudios::UI::Pixel
          */
         bool m_cacheToTexture;
 
+        /**
+         * @brief Defines if the cached texture has been enabled by the canvas cache policy.
+         */
+        bool m_cacheToTextureAuto;
+
+        /**
+         * @brief The rendering statistics used by the canvas cache policy.
+         */
+        WidgetRenderStats m_renderStats;
+
+        /**
+         * @brief The draw operations of the last call to Render().
+         */
+        DisplayList m_displayList;
+
+        /**
+         * @brief Defines if the display list needs to be recorded again.
+         */
+        bool m_displayListDirty;
+
         /**
          * @brief The map of registered events.
          */
@@ -1259,8 +1329,20 @@ namespace SparkyStudios::UI::Pixel
         bool m_includeInSize;
 
     private:
+        /**
+         * @brief Makes the calling thread only record draw commands.
+         *
+         * Widgets rendered on this thread don't think, and their redraws are collected in
+         * the given list instead of being applied, as they would touch shared widgets.
+         *
+         * @param redraws The list of widgets to redraw, or nullptr to stop recording.
+         */
+        static void SetRecordingThread(std::vector<Widget*>* redraws);
+
+        void ThinkRecursive();
         void DoRender(Skin* skin);
-        void DoCacheRender(Skin* skin, Widget* root);
+        void DoCacheRender(Skin* skin);
+        void RenderWithDisplayList(Skin* skin);
     };
 
     /**
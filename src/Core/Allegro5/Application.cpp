@@ -14,9 +14,12 @@
 
 #include <SparkyStudios/UI/Pixel/Core/Animation/Animation.h>
 #include <SparkyStudios/UI/Pixel/Core/Application.h>
+#include <SparkyStudios/UI/Pixel/Core/Log.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
 
 #include <Core/Allegro5/Input/InputHandler.h>
 #include <Core/Allegro5/Renderer/Renderer.h>
+#include <Core/RenderFrameQueue.h>
 
 #include <allegro5/allegro5.h>
 #include <allegro5/allegro_font.h>
@@ -24,6 +27,12 @@
 #include <allegro5/allegro_primitives.h>
 #include <allegro5/allegro_ttf.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 namespace SparkyStudios::UI::Pixel
 {
     static Application* gApplication = nullptr;
@@ -59,8 +68,8 @@ namespace SparkyStudios::UI::Pixel
             if (!gDisplay)
                 return false;
 
-            // Create a time with a fixed FPS of 60
-            gTimer = al_create_timer(1.0 / 60.0);
+            // Create a timer ticking at the maximum frame rate, used in continuous render mode
+            gTimer = al_create_timer(1.0 / _maxFrameRate);
 
             if (!gTimer)
                 return false;
@@ -83,7 +92,8 @@ namespace SparkyStudios::UI::Pixel
             al_register_event_source(gEventQueue, al_get_keyboard_event_source());
             al_register_event_source(gEventQueue, al_get_timer_event_source(gTimer));
 
-            al_start_timer(gTimer);
+            if (_renderMode == RenderMode::Continuous)
+                al_start_timer(gTimer);
 
             SetAppResourcesDirectoryPath(skinData.resourcesDir);
 
@@ -92,6 +102,20 @@ namespace SparkyStudios::UI::Pixel
             _renderer = new Renderer_Allegro(_paths);
             _skin = new Skin(skinData, _renderer);
 
+            // Load the resources declared by the skin before the first frame
+            std::vector<Texture> textures(skinData.Preload.textures.size());
+            for (std::size_t i = 0, l = textures.size(); i < l; ++i)
+                textures[i].name = skinData.Preload.textures[i];
+
+            _preloadTimings = _renderer->Preload(skinData.Preload.fonts, textures);
+
+            for (auto&& timing : _preloadTimings)
+            {
+                Log::Write(
+                    Log::Level::Info, "Preloaded %s in %.2f ms (decode: %.2f ms, upload: %.2f ms)", timing.name.c_str(),
+                    (timing.decodeTime + timing.uploadTime) * 1000.0, timing.decodeTime * 1000.0, timing.uploadTime * 1000.0);
+            }
+
             mainWindow->CreateRootCanvas(_skin);
 
             _mainWindow = mainWindow;
@@ -107,15 +131,60 @@ namespace SparkyStudios::UI::Pixel
         if (!_initialized)
             return EXIT_FAILURE;
 
+        Canvas* canvas = _mainWindow->GetRootCanvas().get();
+
         InputHandler_Allegro inputHandler{};
-        inputHandler.Initialize(_mainWindow->GetRootCanvas().get());
+        inputHandler.Initialize(canvas);
 
-        _running = true;
-        ALLEGRO_EVENT ev;
-        while (_running)
+        RenderFrameQueue* frames = nullptr;
+        DisplayListRecorder* recorder = nullptr;
+        std::mutex rendererMutex;
+        std::thread renderThread;
+
+        if (_renderThreadEnabled)
         {
-            al_wait_for_event(gEventQueue, &ev);
+            // The widgets render through a recorder, which calls the real renderer under the mutex
+            recorder = new DisplayListRecorder(_paths, _renderer);
+            recorder->SetTargetMutex(&rendererMutex);
+            recorder->SetDisplayListsEnabled(_renderer->IsDisplayListsEnabled());
+            _skin->SetRenderer(recorder);
+
+            frames = new RenderFrameQueue(_renderThreadFrameCount);
+            _mainWindow->_renderThreaded = true;
+
+            // Hand the display over to the render thread
+            al_set_target_bitmap(nullptr);
+
+            renderThread = std::thread(
+                [this, frames, &rendererMutex]()
+                {
+                    al_set_target_backbuffer(gDisplay);
+
+                    while (RenderFrame* frame = frames->AcquireSubmitted())
+                    {
+                        _mainWindow->PaintFrame(_renderer, frame, rendererMutex);
+                        frames->Release(frame);
+                    }
+
+                    al_set_target_bitmap(nullptr);
+                });
+        }
+
+        const auto paint = [&]()
+        {
+            if (frames == nullptr)
+                return _mainWindow->Paint(_skin);
+
+            // Waits for the render thread when it is behind by every frame
+            if (RenderFrame* frame = frames->AcquireFree(); frame != nullptr)
+            {
+                _mainWindow->RecordFrame(recorder, _renderer, frame);
+                frames->Submit(frame);
+            }
+        };
 
+        const auto processEvent = [&](const ALLEGRO_EVENT& ev)
+        {
             if (ev.type == ALLEGRO_EVENT_DISPLAY_CLOSE)
                 _running = false;
 
@@ -131,7 +200,14 @@ namespace SparkyStudios::UI::Pixel
             else if (ev.type == ALLEGRO_EVENT_DISPLAY_EXPOSE)
                 _mainWindow->OnExpose();
 
-            else if (ev.type == ALLEGRO_EVENT_TIMER)
+            else if (ev.type == ALLEGRO_EVENT_DISPLAY_FOUND)
+            {
+                // The display has been reset, the bitmaps are uploaded again with the next frame.
+                static_cast<Renderer_Allegro*>(_renderer)->ConvertMemoryBitmapsLater();
+                _mainWindow->OnExpose();
+            }
+
+            else if (ev.type == ALLEGRO_EVENT_TIMER && _renderMode == RenderMode::Continuous)
             {
 #if PI_ENABLE_ANIMATION
                 // Update animation frames
@@ -139,10 +215,80 @@ namespace SparkyStudios::UI::Pixel
 #endif // PI_ENABLE_ANIMATION
 
                 // Paint the widgets
-                _mainWindow->Paint(_skin);
+                paint();
             }
+        };
 
-            al_rest(0.001);
+        _running = true;
+        ALLEGRO_EVENT ev;
+        PiTime lastFrame = -std::numeric_limits<PiTime>::infinity();
+
+        while (_running)
+        {
+            if (_renderMode == RenderMode::Continuous)
+            {
+                al_wait_for_event(gEventQueue, &ev);
+                processEvent(ev);
+                continue;
+            }
+
+            const PiTime now = al_get_time();
+
+            // Find out when the next frame is needed
+            PiTime deadline = canvas->NeedsRedraw() ? now : Canvas::Input::GetNextKeyRepeatTime();
+
+#if PI_ENABLE_ANIMATION
+            deadline = std::min(deadline, Animation::GetNextTickTime(now));
+#endif // PI_ENABLE_ANIMATION
+
+            if (!std::isinf(deadline))
+                deadline = std::max(deadline, lastFrame + 1.0 / _maxFrameRate);
+
+            if (deadline > now)
+            {
+                // Sleep until an event arrives or the next frame is due
+                if (std::isinf(deadline))
+                {
+                    al_wait_for_event(gEventQueue, &ev);
+                    processEvent(ev);
+                }
+                else if (al_wait_for_event_timed(gEventQueue, &ev, static_cast<float>(deadline - now)))
+                {
+                    processEvent(ev);
+                }
+
+                while (_running && al_get_next_event(gEventQueue, &ev))
+                    processEvent(ev);
+
+                continue;
+            }
+
+            lastFrame = now;
+
+#if PI_ENABLE_ANIMATION
+            Animation::Tick(now);
+#endif // PI_ENABLE_ANIMATION
+
+            // Key repeats are simulated while the canvas thinks
+            if (Canvas::Input::GetNextKeyRepeatTime() <= now)
+                canvas->DoThink();
+
+            if (canvas->NeedsRedraw())
+                paint();
+        }
+
+        if (frames != nullptr)
+        {
+            // Paint the remaining frames, then take the display back
+            frames->Close();
+            renderThread.join();
+            al_set_target_backbuffer(gDisplay);
+
+            _mainWindow->_renderThreaded = false;
+            _skin->SetRenderer(_renderer);
+
+            delete frames;
+            delete recorder;
         }
 
         return EXIT_SUCCESS;
@@ -166,9 +312,87 @@ namespace SparkyStudios::UI::Pixel
         return _mainWindow;
     }
 
+    void Application::SetRenderMode(RenderMode mode)
+    {
+        if (_renderMode == mode)
+            return;
+
+        _renderMode = mode;
+
+        if (gTimer == nullptr)
+            return;
+
+        if (_renderMode == RenderMode::Continuous)
+            al_start_timer(gTimer);
+        else
+            al_stop_timer(gTimer);
+    }
+
+    Application::RenderMode Application::GetRenderMode() const
+    {
+        return _renderMode;
+    }
+
+    void Application::SetMaxFrameRate(PiUInt32 fps)
+    {
+        if (fps == 0)
+            return;
+
+        _maxFrameRate = fps;
+
+        if (gTimer != nullptr)
+            al_set_timer_speed(gTimer, 1.0 / _maxFrameRate);
+    }
+
+    PiUInt32 Application::GetMaxFrameRate() const
+    {
+        return _maxFrameRate;
+    }
+
+    void Application::SetRenderThreadEnabled(bool enabled)
+    {
+        if (_running)
+        {
+            Log::Write(Log::Level::Error, "The render thread can't be enabled or disabled while the application runs.");
+            return;
+        }
+
+        _renderThreadEnabled = enabled;
+    }
+
+    bool Application::IsRenderThreadEnabled() const
+    {
+        return _renderThreadEnabled;
+    }
+
+    void Application::SetRenderThreadFrameCount(PiUInt32 count)
+    {
+        if (_running)
+        {
+            Log::Write(Log::Level::Error, "The render thread frame count can't be changed while the application runs.");
+            return;
+        }
+
+        _renderThreadFrameCount = std::clamp(count, 2u, 3u);
+    }
+
+    PiUInt32 Application::GetRenderThreadFrameCount() const
+    {
+        return _renderThreadFrameCount;
+    }
+
+    const std::vector<BaseRenderer::PreloadTiming>& Application::GetPreloadTimings() const
+    {
+        return _preloadTimings;
+    }
+
     Application::Application()
         : _initialized(false)
         , _running(false)
+        , _renderMode(RenderMode::Continuous)
+        , _maxFrameRate(60)
+        , _renderThreadEnabled(false)
+        , _renderThreadFrameCount(2)
         , _mainWindow(nullptr)
         , _paths()
         , _skin(nullptr)
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include <SparkyStudios/UI/Pixel/Core/MainWindow.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
+
+#include <Core/RenderFrameQueue.h>
 
 #include <allegro5/allegro5.h>
 #include <allegro5/allegro_native_dialog.h>
@@ -64,6 +67,8 @@ namespace SparkyStudios::UI::Pixel
         , _size(width, height)
         , _cursor(new Cursor(this))
         , _defaultCursorStyle(CursorStyle::Default)
+        , _renderThreaded(false)
+        , _resizePending(false)
     {}
 
     MainWindow::MainWindow(PiUInt32 width, PiUInt32 height, const PiString& title, int flags)
@@ -92,6 +97,10 @@ namespace SparkyStudios::UI::Pixel
 
         al_set_new_display_flags(TranslateToAllegroFlags(_flags) | ALLEGRO_GENERATE_EXPOSE_EVENTS);
 
+        // Ask for a preserved backbuffer, so that dirty rectangles can be presented alone.
+        al_set_new_display_option(ALLEGRO_SWAP_METHOD, 1, ALLEGRO_SUGGEST);
+        al_set_new_display_option(ALLEGRO_UPDATE_DISPLAY_REGION, 1, ALLEGRO_SUGGEST);
+
         _nativeHandle = al_create_display(_size.w, _size.h);
 
         if (!_nativeHandle)
@@ -250,23 +259,124 @@ namespace SparkyStudios::UI::Pixel
 
     void MainWindow::OnResize(const Size& newSize)
     {
-        al_acknowledge_resize(static_cast<ALLEGRO_DISPLAY*>(_nativeHandle));
+        // The render thread owns the display, it acknowledges the resize before painting the next frame.
+        if (_renderThreaded)
+            _resizePending = true;
+        else
+            al_acknowledge_resize(static_cast<ALLEGRO_DISPLAY*>(_nativeHandle));
+
         _rootCanvas->SetSize(newSize);
     }
 
     void MainWindow::OnExpose()
-    {}
+    {
+        // The content of the window is lost, render it entirely on the next frame.
+        _rootCanvas->Redraw();
+    }
 
     void MainWindow::Paint(Skin* skin)
     {
         if (skin == nullptr)
             return;
 
-        skin->GetRenderer()->BeginContext(this);
+        BaseRenderer* renderer = skin->GetRenderer();
+
+        // The damaged region is converted to pixels at the scale of this frame.
+        renderer->SetScale(_rootCanvas->GetScale());
+
+        if (_rootCanvas->IsDirtyRectsEnabled())
+        {
+            if (renderer->CanPresentRegion(this))
+            {
+                _rootCanvas->PrepareRender();
+                const Rect region = _rootCanvas->GetRenderedRect();
+
+                renderer->BeginContext(this, region);
+                {
+                    _rootCanvas->RenderCanvas();
+                }
+                renderer->PresentContext(this, region);
+                renderer->EndContext(this);
+                return;
+            }
+
+            // The previous frame is not preserved, fall back to full frames.
+            _rootCanvas->Redraw();
+        }
+
+        renderer->BeginContext(this);
         {
             _rootCanvas->RenderCanvas();
         }
-        skin->GetRenderer()->PresentContext(this);
-        skin->GetRenderer()->EndContext(this);
+        renderer->PresentContext(this);
+        renderer->EndContext(this);
+    }
+
+    void MainWindow::RecordFrame(DisplayListRecorder* recorder, BaseRenderer* target, RenderFrame* frame)
+    {
+        frame->list.Clear();
+        frame->partial = false;
+
+        if (_rootCanvas->IsDirtyRectsEnabled())
+        {
+            if (target->CanPresentRegion(this))
+                frame->partial = true;
+            else
+                _rootCanvas->Redraw(); // The previous frame is not preserved, fall back to full frames.
+        }
+
+        _rootCanvas->PrepareRender();
+
+        frame->region = _rootCanvas->GetRenderedRect();
+        frame->scale = _rootCanvas->GetScale();
+        frame->acknowledgeResize = _resizePending;
+        _resizePending = false;
+
+        recorder->SetDisplayList(&frame->list);
+        {
+            _rootCanvas->RenderCanvas();
+        }
+        recorder->SetDisplayList(nullptr);
+    }
+
+    void MainWindow::PaintFrame(BaseRenderer* renderer, RenderFrame* frame, std::mutex& mutex)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (frame->acknowledgeResize)
+                al_acknowledge_resize(static_cast<ALLEGRO_DISPLAY*>(_nativeHandle));
+
+            renderer->SetScale(frame->scale);
+
+            if (frame->partial)
+                renderer->BeginContext(this, frame->region);
+            else
+                renderer->BeginContext(this);
+
+            if (!frame->region.IsEmpty())
+            {
+                renderer->Begin();
+                {
+                    renderer->SetClipRegion(frame->region);
+                    renderer->SetRenderOffset(Point(0, 0));
+
+                    renderer->StartClip();
+                    {
+                        frame->list.Replay(renderer);
+                    }
+                    renderer->EndClip();
+                }
+                renderer->End();
+            }
+        }
+
+        // The batch has been flushed, presenting doesn't need the UI thread to wait.
+        if (frame->partial)
+            renderer->PresentContext(this, frame->region);
+        else
+            renderer->PresentContext(this);
+
+        renderer->EndContext(this);
     }
 } // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,297 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/Allegro5/Renderer/BakedFont.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace SparkyStudios::UI::Pixel
+{
+    static constexpr char kFontMagic[4] = { 'P', 'I', 'F', 'N' };
+
+    // The size of the file header, of the header of a face, of a glyph and of a kerning pair.
+    static constexpr PiUInt64 kHeaderSize = 16;
+    static constexpr PiUInt64 kFaceSize = 24;
+    static constexpr PiUInt64 kGlyphSize = 20;
+    static constexpr PiUInt64 kKerningSize = 12;
+
+    static PiUInt64 ReadUInt(const PiUInt8* data, PiUInt32 bytes)
+    {
+        PiUInt64 value = 0;
+
+        for (PiUInt32 i = 0; i < bytes; ++i)
+            value |= static_cast<PiUInt64>(data[i]) << (i * 8);
+
+        return value;
+    }
+
+    static void WriteUInt(std::ofstream& stream, PiUInt64 value, PiUInt32 bytes)
+    {
+        for (PiUInt32 i = 0; i < bytes; ++i)
+            stream.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    static PiUInt64 GetKerningKey(PiInt32 first, PiInt32 second)
+    {
+        return (static_cast<PiUInt64>(static_cast<PiUInt32>(first)) << 32) | static_cast<PiUInt32>(second);
+    }
+
+    bool BakedFont_Allegro::Write(const PiString& path, const std::vector<Face>& faces)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file)
+            return false;
+
+        file.write(kFontMagic, sizeof(kFontMagic));
+        WriteUInt(file, kVersion, 4);
+        WriteUInt(file, faces.size(), 4);
+        WriteUInt(file, 0, 4);
+
+        for (auto&& face : faces)
+        {
+            WriteUInt(file, static_cast<PiUInt32>(face.pixelSize), 4);
+            WriteUInt(file, static_cast<PiUInt32>(face.lineHeight), 4);
+            WriteUInt(file, face.glyphs.size(), 4);
+            WriteUInt(file, face.kerning.size(), 4);
+            WriteUInt(file, face.atlasWidth, 4);
+            WriteUInt(file, face.atlasHeight, 4);
+
+            for (auto&& glyph : face.glyphs)
+            {
+                WriteUInt(file, glyph.codepoint, 4);
+                WriteUInt(file, glyph.x, 2);
+                WriteUInt(file, glyph.y, 2);
+                WriteUInt(file, glyph.w, 2);
+                WriteUInt(file, glyph.h, 2);
+                WriteUInt(file, static_cast<PiUInt16>(glyph.offsetX), 2);
+                WriteUInt(file, static_cast<PiUInt16>(glyph.offsetY), 2);
+                WriteUInt(file, static_cast<PiUInt16>(glyph.advance), 2);
+                WriteUInt(file, 0, 2);
+            }
+
+            for (auto&& kerning : face.kerning)
+            {
+                WriteUInt(file, kerning.first, 4);
+                WriteUInt(file, kerning.second, 4);
+                WriteUInt(file, static_cast<PiUInt32>(kerning.amount), 4);
+            }
+
+            file.write(reinterpret_cast<const char*>(face.coverage.data()), static_cast<std::streamsize>(face.coverage.size()));
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    BakedFont_Allegro* BakedFont_Allegro::Load(const void* data, PiUInt64 size, PiInt32 pixelSize)
+    {
+        const auto* bytes = static_cast<const PiUInt8*>(data);
+
+        if (size < kHeaderSize || std::memcmp(bytes, kFontMagic, sizeof(kFontMagic)) != 0 || ReadUInt(bytes + 4, 4) != kVersion)
+            return nullptr;
+
+        const PiUInt64 faceCount = ReadUInt(bytes + 8, 4);
+        PiUInt64 position = kHeaderSize;
+
+        for (PiUInt64 i = 0; i < faceCount && position + kFaceSize <= size; ++i)
+        {
+            const auto facePixelSize = static_cast<PiInt32>(ReadUInt(bytes + position, 4));
+            const auto lineHeight = static_cast<PiInt32>(ReadUInt(bytes + position + 4, 4));
+            const PiUInt64 glyphCount = ReadUInt(bytes + position + 8, 4);
+            const PiUInt64 kerningCount = ReadUInt(bytes + position + 12, 4);
+            const auto atlasWidth = static_cast<PiInt32>(ReadUInt(bytes + position + 16, 4));
+            const auto atlasHeight = static_cast<PiInt32>(ReadUInt(bytes + position + 20, 4));
+            position += kFaceSize;
+
+            const PiUInt64 glyphsStart = position;
+            const PiUInt64 kerningStart = glyphsStart + glyphCount * kGlyphSize;
+            const PiUInt64 coverageStart = kerningStart + kerningCount * kKerningSize;
+            position = coverageStart + static_cast<PiUInt64>(atlasWidth) * static_cast<PiUInt64>(atlasHeight);
+
+            if (position > size)
+                return nullptr;
+
+            if (facePixelSize != pixelSize)
+                continue;
+
+            ALLEGRO_BITMAP* atlas = al_create_bitmap(atlasWidth, atlasHeight);
+
+            if (atlas == nullptr)
+                return nullptr;
+
+            ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(atlas, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+
+            if (region == nullptr)
+            {
+                al_destroy_bitmap(atlas);
+                return nullptr;
+            }
+
+            // Glyphs are white, with premultiplied alpha.
+            const PiUInt8* coverage = bytes + coverageStart;
+            auto* row = static_cast<PiUInt8*>(region->data);
+
+            for (PiInt32 y = 0; y < atlasHeight; ++y, row += region->pitch)
+            {
+                for (PiInt32 x = 0; x < atlasWidth; ++x)
+                    std::memset(row + x * 4, *coverage++, 4);
+            }
+
+            al_unlock_bitmap(atlas);
+
+            auto* font = new BakedFont_Allegro();
+            font->_atlas = atlas;
+            font->_lineHeight = lineHeight;
+            font->_glyphs.reserve(glyphCount);
+
+            for (PiUInt64 g = 0; g < glyphCount; ++g)
+            {
+                const PiUInt8* entry = bytes + glyphsStart + g * kGlyphSize;
+
+                Glyph glyph;
+                glyph.codepoint = static_cast<PiUInt32>(ReadUInt(entry, 4));
+                glyph.x = static_cast<PiUInt16>(ReadUInt(entry + 4, 2));
+                glyph.y = static_cast<PiUInt16>(ReadUInt(entry + 6, 2));
+                glyph.w = static_cast<PiUInt16>(ReadUInt(entry + 8, 2));
+                glyph.h = static_cast<PiUInt16>(ReadUInt(entry + 10, 2));
+                glyph.offsetX = static_cast<PiInt16>(ReadUInt(entry + 12, 2));
+                glyph.offsetY = static_cast<PiInt16>(ReadUInt(entry + 14, 2));
+                glyph.advance = static_cast<PiInt16>(ReadUInt(entry + 16, 2));
+
+                font->_glyphs[static_cast<PiInt32>(glyph.codepoint)] = glyph;
+            }
+
+            for (PiUInt64 k = 0; k < kerningCount; ++k)
+            {
+                const PiUInt8* entry = bytes + kerningStart + k * kKerningSize;
+
+                const auto first = static_cast<PiInt32>(ReadUInt(entry, 4));
+                const auto second = static_cast<PiInt32>(ReadUInt(entry + 4, 4));
+                font->_kerning[GetKerningKey(first, second)] = static_cast<PiInt32>(ReadUInt(entry + 8, 4));
+            }
+
+            return font;
+        }
+
+        return nullptr;
+    }
+
+    BakedFont_Allegro::BakedFont_Allegro()
+        : _atlas(nullptr)
+        , _lineHeight(0)
+    {}
+
+    BakedFont_Allegro::~BakedFont_Allegro()
+    {
+        if (_atlas != nullptr)
+            al_destroy_bitmap(_atlas);
+    }
+
+    void BakedFont_Allegro::Upload()
+    {
+        if (al_get_current_display() != nullptr && (al_get_bitmap_flags(_atlas) & ALLEGRO_MEMORY_BITMAP) != 0)
+            al_convert_bitmap(_atlas);
+    }
+
+    const GlyphAtlas_Allegro::GlyphRun& BakedFont_Allegro::BuildRun(const PiString& text)
+    {
+        if (const GlyphAtlas_Allegro::GlyphRun* run = _runs.Find(text))
+            return *run;
+
+        GlyphAtlas_Allegro::GlyphRun run;
+        run.quads.reserve(text.size());
+        run.height = _lineHeight;
+
+        ALLEGRO_USTR_INFO info;
+        const ALLEGRO_USTR* ustr = al_ref_cstr(&info, text.c_str());
+
+        PiInt32 penX = 0;
+        PiInt32 previous = -1;
+        int position = 0;
+        PiInt32 codepoint;
+
+        while ((codepoint = al_ustr_get_next(ustr, &position)) >= 0)
+        {
+            penX += GetKerning(previous, codepoint);
+            previous = codepoint;
+
+            const auto it = _glyphs.find(codepoint);
+
+            // Glyphs which were not baked are skipped.
+            if (it == _glyphs.end())
+                continue;
+
+            const Glyph& glyph = it->second;
+
+            if (glyph.w > 0 && glyph.h > 0)
+            {
+                GlyphAtlas_Allegro::GlyphQuad quad;
+                quad.x1 = penX + glyph.offsetX;
+                quad.y1 = glyph.offsetY;
+                quad.x2 = quad.x1 + glyph.w;
+                quad.y2 = quad.y1 + glyph.h;
+                quad.u1 = glyph.x;
+                quad.v1 = glyph.y;
+                quad.u2 = glyph.x + glyph.w;
+                quad.v2 = glyph.y + glyph.h;
+                quad.page = _atlas;
+
+                run.quads.push_back(quad);
+            }
+
+            penX += glyph.advance;
+        }
+
+        run.width = penX;
+
+        return _runs.Add(text, std::move(run));
+    }
+
+    PiReal32 BakedFont_Allegro::MeasureWidth(const PiString& text) const
+    {
+        ALLEGRO_USTR_INFO info;
+        const ALLEGRO_USTR* ustr = al_ref_cstr(&info, text.c_str());
+
+        PiInt32 width = 0;
+        PiInt32 previous = -1;
+        int position = 0;
+        PiInt32 codepoint;
+
+        while ((codepoint = al_ustr_get_next(ustr, &position)) >= 0)
+        {
+            width += GetKerning(previous, codepoint);
+            previous = codepoint;
+
+            if (const auto it = _glyphs.find(codepoint); it != _glyphs.end())
+                width += it->second.advance;
+        }
+
+        return width;
+    }
+
+    PiInt32 BakedFont_Allegro::GetLineHeight() const
+    {
+        return _lineHeight;
+    }
+
+    PiInt32 BakedFont_Allegro::GetKerning(PiInt32 first, PiInt32 second) const
+    {
+        if (first < 0 || _kerning.empty())
+            return 0;
+
+        const auto it = _kerning.find(GetKerningKey(first, second));
+        return it != _kerning.end() ? it->second : 0;
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,136 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_BAKED_FONT_H
+#define PIXEL_UI_BAKED_FONT_H
+
+#include <Core/Allegro5/Renderer/GlyphAtlas.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A font rasterized offline at a given pixel size, loaded without FreeType.
+     *
+     * Baked font files are written by the FontBaker tool. They start with the "PIFN" magic,
+     * the format version and the number of sizes, followed by each size: its metrics, the
+     * glyph metrics sorted by codepoint, the kerning pairs, and the coverage of the atlas
+     * image, one byte per pixel. All the values are stored in little endian.
+     */
+    class BakedFont_Allegro
+    {
+    public:
+        /**
+         * @brief The version of the baked font format.
+         */
+        static constexpr PiUInt32 kVersion = 1;
+
+        /**
+         * @brief The position of a glyph in the atlas image, and its metrics.
+         */
+        struct Glyph
+        {
+            PiUInt32 codepoint;
+            PiUInt16 x, y, w, h;
+            PiInt16 offsetX, offsetY;
+            PiInt16 advance;
+        };
+
+        /**
+         * @brief The advance adjustment between two glyphs.
+         */
+        struct Kerning
+        {
+            PiUInt32 first;
+            PiUInt32 second;
+            PiInt32 amount;
+        };
+
+        /**
+         * @brief A font rasterized at a single pixel size.
+         */
+        struct Face
+        {
+            PiInt32 pixelSize;
+            PiInt32 lineHeight;
+            std::vector<Glyph> glyphs;
+            std::vector<Kerning> kerning;
+            PiUInt32 atlasWidth;
+            PiUInt32 atlasHeight;
+            std::vector<PiUInt8> coverage;
+        };
+
+        /**
+         * @brief Writes a baked font file.
+         *
+         * @param path The path of the file to write.
+         * @param faces The sizes of the baked font.
+         *
+         * @return Whether the file has been written.
+         */
+        static bool Write(const PiString& path, const std::vector<Face>& faces);
+
+        /**
+         * @brief Loads a size of a baked font, and creates its atlas bitmap.
+         *
+         * @param data The content of the baked font file.
+         * @param size The size of the content, in bytes.
+         * @param pixelSize The pixel size to load.
+         *
+         * @return The font, or nullptr if the file is invalid or doesn't contain the pixel size.
+         */
+        static BakedFont_Allegro* Load(const void* data, PiUInt64 size, PiInt32 pixelSize);
+
+        ~BakedFont_Allegro();
+
+        /**
+         * @brief Converts the atlas to a video bitmap, if it has been loaded without a display.
+         */
+        void Upload();
+
+        BakedFont_Allegro(const BakedFont_Allegro&) = delete;
+        BakedFont_Allegro& operator=(const BakedFont_Allegro&) = delete;
+
+        /**
+         * @brief Builds and caches the glyph run of the given text.
+         *
+         * The glyphs are already in the atlas bitmap, so pending draw operations don't need to be flushed.
+         */
+        const GlyphAtlas_Allegro::GlyphRun& BuildRun(const PiString& text);
+
+        /**
+         * @brief Measures the width of the given text from the glyph advances, in pixels.
+         */
+        [[nodiscard]] PiReal32 MeasureWidth(const PiString& text) const;
+
+        [[nodiscard]] PiInt32 GetLineHeight() const;
+
+    private:
+        BakedFont_Allegro();
+
+        [[nodiscard]] PiInt32 GetKerning(PiInt32 first, PiInt32 second) const;
+
+        ALLEGRO_BITMAP* _atlas;
+        PiInt32 _lineHeight;
+        std::unordered_map<PiInt32, Glyph> _glyphs;
+        std::unordered_map<PiUInt64, PiInt32> _kerning;
+        GlyphAtlas_Allegro::RunCache _runs;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_BAKED_FONT_H
@@ -0,0 +1,134 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/Allegro5/Renderer/DrawBatch.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    // Upper bound of vertices held by a single batch, to keep memory usage under control.
+    static constexpr std::size_t kMaxBatchVertices = 65536;
+
+    DrawBatch_Allegro::DrawBatch_Allegro()
+        : _texture(nullptr)
+    {
+        _vertices.reserve(4096);
+        _indices.reserve(6144);
+    }
+
+    void DrawBatch_Allegro::AddQuad(
+        PiReal32 x1,
+        PiReal32 y1,
+        PiReal32 x2,
+        PiReal32 y2,
+        PiReal32 u1,
+        PiReal32 v1,
+        PiReal32 u2,
+        PiReal32 v2,
+        const ALLEGRO_COLOR& color,
+        ALLEGRO_BITMAP* texture)
+    {
+        Prepare(texture, 4);
+
+        const int base = static_cast<int>(_vertices.size());
+
+        PushVertex(x1, y1, u1, v1, color);
+        PushVertex(x2, y1, u2, v1, color);
+        PushVertex(x2, y2, u2, v2, color);
+        PushVertex(x1, y2, u1, v2, color);
+
+        _indices.insert(_indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+
+    void DrawBatch_Allegro::AddRect(PiReal32 x1, PiReal32 y1, PiReal32 x2, PiReal32 y2, const ALLEGRO_COLOR& color)
+    {
+        AddQuad(x1, y1, x2, y2, 0.0f, 0.0f, 0.0f, 0.0f, color, nullptr);
+    }
+
+    void DrawBatch_Allegro::AddTriangle(
+        PiReal32 x1, PiReal32 y1, PiReal32 x2, PiReal32 y2, PiReal32 x3, PiReal32 y3, const ALLEGRO_COLOR& color)
+    {
+        Prepare(nullptr, 3);
+
+        const int base = static_cast<int>(_vertices.size());
+
+        PushVertex(x1, y1, 0.0f, 0.0f, color);
+        PushVertex(x2, y2, 0.0f, 0.0f, color);
+        PushVertex(x3, y3, 0.0f, 0.0f, color);
+
+        _indices.insert(_indices.end(), { base, base + 1, base + 2 });
+    }
+
+    void DrawBatch_Allegro::AddGeometry(const ShapeCache_Allegro::Geometry& geometry, PiReal32 x, PiReal32 y, const ALLEGRO_COLOR& color)
+    {
+        Prepare(nullptr, geometry.vertices.size());
+
+        const int base = static_cast<int>(_vertices.size());
+
+        for (auto&& vertex : geometry.vertices)
+            PushVertex(x + vertex.x, y + vertex.y, 0.0f, 0.0f, color);
+
+        for (auto&& index : geometry.indices)
+            _indices.push_back(base + index);
+    }
+
+    PiUInt32 DrawBatch_Allegro::Flush()
+    {
+        if (IsEmpty())
+            return 0;
+
+        al_draw_indexed_prim(
+            _vertices.data(), nullptr, _texture, _indices.data(), static_cast<int>(_indices.size()), ALLEGRO_PRIM_TRIANGLE_LIST);
+
+        Clear();
+        return 1;
+    }
+
+    void DrawBatch_Allegro::Clear()
+    {
+        _vertices.clear();
+        _indices.clear();
+        _texture = nullptr;
+    }
+
+    bool DrawBatch_Allegro::IsEmpty() const
+    {
+        return _indices.empty();
+    }
+
+    bool DrawBatch_Allegro::CanAppend(ALLEGRO_BITMAP* texture, std::size_t vertexCount) const
+    {
+        return IsEmpty() || (texture == _texture && _vertices.size() + vertexCount <= kMaxBatchVertices);
+    }
+
+    void DrawBatch_Allegro::Prepare(ALLEGRO_BITMAP* texture, std::size_t vertexCount)
+    {
+        if (!CanAppend(texture, vertexCount))
+            Flush();
+
+        _texture = texture;
+    }
+
+    void DrawBatch_Allegro::PushVertex(PiReal32 x, PiReal32 y, PiReal32 u, PiReal32 v, const ALLEGRO_COLOR& color)
+    {
+        ALLEGRO_VERTEX vertex;
+        vertex.x = x;
+        vertex.y = y;
+        vertex.z = 0.0f;
+        vertex.u = u;
+        vertex.v = v;
+        vertex.color = color;
+
+        _vertices.push_back(vertex);
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,144 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_DRAW_BATCH_H
+#define PIXEL_UI_DRAW_BATCH_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <Core/Allegro5/Renderer/ShapeCache.h>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Collects geometry into a single vertex/index stream to
+     * submit it with as few draw calls as possible.
+     *
+     * A batch can only hold geometry sharing the same texture. Callers
+     * are responsible to flush the batch before any change of the
+     * drawing state (clipping rectangle, target bitmap, etc.).
+     */
+    class DrawBatch_Allegro
+    {
+    public:
+        DrawBatch_Allegro();
+
+        /**
+         * @brief Checks if the given geometry can be appended to the pending one.
+         *
+         * @param texture The texture used by the geometry.
+         * @param vertexCount The number of vertices of the geometry.
+         *
+         * @return Whether the geometry can be appended without flushing the batch.
+         */
+        [[nodiscard]] bool CanAppend(ALLEGRO_BITMAP* texture, std::size_t vertexCount) const;
+
+        /**
+         * @brief Adds an axis aligned quad to the batch.
+         *
+         * If the geometry cannot be appended to the pending one,
+         * the batch is flushed first.
+         *
+         * @param x1 The left coordinate of the quad.
+         * @param y1 The top coordinate of the quad.
+         * @param x2 The right coordinate of the quad.
+         * @param y2 The bottom coordinate of the quad.
+         * @param u1 The left texture coordinate, in pixels.
+         * @param v1 The top texture coordinate, in pixels.
+         * @param u2 The right texture coordinate, in pixels.
+         * @param v2 The bottom texture coordinate, in pixels.
+         * @param color The color of the quad vertices.
+         * @param texture The texture to use, or nullptr for a solid quad.
+         */
+        void AddQuad(
+            PiReal32 x1,
+            PiReal32 y1,
+            PiReal32 x2,
+            PiReal32 y2,
+            PiReal32 u1,
+            PiReal32 v1,
+            PiReal32 u2,
+            PiReal32 v2,
+            const ALLEGRO_COLOR& color,
+            ALLEGRO_BITMAP* texture);
+
+        /**
+         * @brief Adds a solid axis aligned quad to the batch.
+         *
+         * @param x1 The left coordinate of the quad.
+         * @param y1 The top coordinate of the quad.
+         * @param x2 The right coordinate of the quad.
+         * @param y2 The bottom coordinate of the quad.
+         * @param color The color of the quad.
+         */
+        void AddRect(PiReal32 x1, PiReal32 y1, PiReal32 x2, PiReal32 y2, const ALLEGRO_COLOR& color);
+
+        /**
+         * @brief Adds a solid triangle to the batch.
+         *
+         * @param x1 The X coordinate of the first point.
+         * @param y1 The Y coordinate of the first point.
+         * @param x2 The X coordinate of the second point.
+         * @param y2 The Y coordinate of the second point.
+         * @param x3 The X coordinate of the third point.
+         * @param y3 The Y coordinate of the third point.
+         * @param color The color of the triangle.
+         */
+        void AddTriangle(PiReal32 x1, PiReal32 y1, PiReal32 x2, PiReal32 y2, PiReal32 x3, PiReal32 y3, const ALLEGRO_COLOR& color);
+
+        /**
+         * @brief Adds a solid tessellated shape to the batch.
+         *
+         * @param geometry The triangles of the shape.
+         * @param x The X coordinate of the top left corner of the shape bounds.
+         * @param y The Y coordinate of the top left corner of the shape bounds.
+         * @param color The color of the shape.
+         */
+        void AddGeometry(const ShapeCache_Allegro::Geometry& geometry, PiReal32 x, PiReal32 y, const ALLEGRO_COLOR& color);
+
+        /**
+         * @brief Submits the pending geometry to Allegro.
+         *
+         * @return The number of draw calls issued.
+         */
+        PiUInt32 Flush();
+
+        /**
+         * @brief Discards the pending geometry without drawing it.
+         */
+        void Clear();
+
+        /**
+         * @brief Checks if the batch has pending geometry.
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+    private:
+        void Prepare(ALLEGRO_BITMAP* texture, std::size_t vertexCount);
+        void PushVertex(PiReal32 x, PiReal32 y, PiReal32 u, PiReal32 v, const ALLEGRO_COLOR& color);
+
+        std::vector<ALLEGRO_VERTEX> _vertices;
+        std::vector<int> _indices;
+        ALLEGRO_BITMAP* _texture;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_DRAW_BATCH_H
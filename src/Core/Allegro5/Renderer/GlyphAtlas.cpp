@@ -0,0 +1,320 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/Allegro5/Renderer/GlyphAtlas.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    static constexpr PiInt32 kPageSize = 1024;
+    static constexpr std::size_t kMaxPages = 4;
+    static constexpr PiInt32 kGlyphPadding = 1;
+
+    static_assert(kMaxPages <= 32, "The pages of a glyph run are stored as a 32 bits mask.");
+
+    GlyphAtlas_Allegro::GlyphAtlas_Allegro()
+        : _uses(0)
+    {}
+
+    GlyphAtlas_Allegro::~GlyphAtlas_Allegro()
+    {
+        for (auto* page : _pages)
+            al_destroy_bitmap(page);
+    }
+
+    const GlyphAtlas_Allegro::GlyphRun* GlyphAtlas_Allegro::FindRun(ALLEGRO_FONT* font, const PiString& text)
+    {
+        auto entry = _fonts.find(font);
+        if (entry == _fonts.end())
+            return nullptr;
+
+        const GlyphRun* run = entry->second.runs.Find(text);
+        if (run != nullptr)
+            TouchPages(run->pages);
+
+        return run;
+    }
+
+    const GlyphAtlas_Allegro::GlyphRun& GlyphAtlas_Allegro::BuildRun(ALLEGRO_FONT* font, const PiString& text)
+    {
+        if (const GlyphRun* run = FindRun(font, text))
+            return *run;
+
+        GlyphRun run;
+
+        // When the atlas is full, clear the least recently used pages, each one at most once.
+        // Glyphs which still don't fit are skipped.
+        std::size_t evictions = 0;
+        while (!TryBuildRun(font, text, run) && evictions < _pages.size())
+        {
+            EvictPage();
+            evictions++;
+        }
+
+        return _fonts[font].runs.Add(text, std::move(run));
+    }
+
+    PiReal32 GlyphAtlas_Allegro::MeasureWidth(ALLEGRO_FONT* font, const PiString& text)
+    {
+        FontEntry& entry = _fonts[font];
+
+        ALLEGRO_USTR_INFO info;
+        const ALLEGRO_USTR* ustr = al_ref_cstr(&info, text.c_str());
+
+        PiInt32 width = 0;
+        int position = 0;
+        PiInt32 codepoint;
+
+        while ((codepoint = al_ustr_get_next(ustr, &position)) >= 0)
+            width += GetGlyph(entry, font, codepoint).advance;
+
+        return width;
+    }
+
+    void GlyphAtlas_Allegro::Forget(ALLEGRO_FONT* font)
+    {
+        _fonts.erase(font);
+    }
+
+    void GlyphAtlas_Allegro::Clear()
+    {
+        for (auto&& entry : _fonts)
+        {
+            entry.second.glyphs.clear();
+            entry.second.runs.Clear();
+        }
+
+        if (!_pages.empty())
+        {
+            ALLEGRO_STATE state;
+            al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+
+            for (auto* page : _pages)
+            {
+                al_set_target_bitmap(page);
+                al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+            }
+
+            al_restore_state(&state);
+        }
+
+        for (auto&& packer : _packers)
+            packer.Clear();
+    }
+
+    bool GlyphAtlas_Allegro::TryBuildRun(ALLEGRO_FONT* font, const PiString& text, GlyphRun& run)
+    {
+        FontEntry& entry = _fonts[font];
+
+        run.quads.clear();
+        run.quads.reserve(text.size());
+        run.height = al_get_font_line_height(font);
+        run.pages = 0;
+
+        // The pages used by this run are the most recently used ones, so they are evicted last.
+        _uses++;
+
+        ALLEGRO_USTR_INFO info;
+        const ALLEGRO_USTR* ustr = al_ref_cstr(&info, text.c_str());
+
+        ALLEGRO_STATE state;
+        bool stateStored = false;
+        bool complete = true;
+
+        PiInt32 penX = 0;
+        int position = 0;
+        PiInt32 codepoint;
+
+        while ((codepoint = al_ustr_get_next(ustr, &position)) >= 0)
+        {
+            Glyph& glyph = GetGlyph(entry, font, codepoint);
+
+            if (!glyph.rasterized)
+            {
+                if (!stateStored)
+                {
+                    al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+                    stateStored = true;
+                }
+
+                complete &= Rasterize(font, codepoint, glyph);
+            }
+
+            if (glyph.page != nullptr)
+            {
+                GlyphQuad quad;
+                quad.x1 = penX + glyph.offsetX;
+                quad.y1 = glyph.offsetY;
+                quad.x2 = quad.x1 + glyph.w;
+                quad.y2 = quad.y1 + glyph.h;
+                quad.u1 = glyph.x;
+                quad.v1 = glyph.y;
+                quad.u2 = glyph.x + glyph.w;
+                quad.v2 = glyph.y + glyph.h;
+                quad.page = glyph.page;
+
+                run.quads.push_back(quad);
+                run.pages |= 1u << glyph.pageIndex;
+                _pageUses[glyph.pageIndex] = _uses;
+            }
+
+            penX += glyph.advance;
+        }
+
+        run.width = penX;
+
+        if (stateStored)
+            al_restore_state(&state);
+
+        return complete;
+    }
+
+    GlyphAtlas_Allegro::Glyph& GlyphAtlas_Allegro::GetGlyph(FontEntry& entry, ALLEGRO_FONT* font, PiInt32 codepoint)
+    {
+        auto it = entry.glyphs.find(codepoint);
+        if (it != entry.glyphs.end())
+            return it->second;
+
+        Glyph glyph;
+        glyph.advance = al_get_glyph_advance(font, codepoint, ALLEGRO_NO_KERNING);
+
+        return entry.glyphs.emplace(codepoint, glyph).first->second;
+    }
+
+    bool GlyphAtlas_Allegro::Rasterize(ALLEGRO_FONT* font, PiInt32 codepoint, Glyph& glyph)
+    {
+        int bbx, bby, bbw, bbh;
+        if (!al_get_glyph_dimensions(font, codepoint, &bbx, &bby, &bbw, &bbh) || bbw <= 0 || bbh <= 0 ||
+            bbw + kGlyphPadding > kPageSize || bbh + kGlyphPadding > kPageSize)
+        {
+            // Nothing to draw for this glyph (eg. whitespaces), or the glyph can never fit in a page.
+            glyph.rasterized = true;
+            return true;
+        }
+
+        std::size_t index = 0;
+        PiInt32 x = 0, y = 0;
+
+        if (!Allocate(bbw, bbh, index, x, y))
+            return false;
+
+        ALLEGRO_BITMAP* page = _pages[index];
+
+        al_set_target_bitmap(page);
+        al_draw_glyph(font, al_map_rgb(255, 255, 255), x - bbx, y - bby, codepoint);
+
+        glyph.page = page;
+        glyph.pageIndex = index;
+        glyph.x = x;
+        glyph.y = y;
+        glyph.w = bbw;
+        glyph.h = bbh;
+        glyph.offsetX = bbx;
+        glyph.offsetY = bby;
+        glyph.rasterized = true;
+
+        return true;
+    }
+
+    bool GlyphAtlas_Allegro::Allocate(PiInt32 w, PiInt32 h, std::size_t& index, PiInt32& x, PiInt32& y)
+    {
+        Rect region;
+        index = 0;
+
+        while (index < _packers.size() && !_packers[index].Pack(w, h, region))
+            ++index;
+
+        if (index == _packers.size())
+        {
+            if (index >= kMaxPages)
+                return false;
+
+            const int flags = al_get_new_bitmap_flags();
+            al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
+            ALLEGRO_BITMAP* bitmap = al_create_bitmap(kPageSize, kPageSize);
+            al_set_new_bitmap_flags(flags);
+
+            if (bitmap == nullptr)
+                return false;
+
+            al_set_target_bitmap(bitmap);
+            al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+
+            _pages.push_back(bitmap);
+            _packers.emplace_back(kPageSize, kPageSize, kGlyphPadding);
+            _pageUses.push_back(_uses);
+
+            if (!_packers.back().Pack(w, h, region))
+                return false;
+        }
+
+        x = region.x;
+        y = region.y;
+
+        return true;
+    }
+
+    void GlyphAtlas_Allegro::TouchPages(PiUInt32 pages)
+    {
+        _uses++;
+
+        for (std::size_t i = 0; i < _pages.size(); ++i)
+        {
+            if ((pages & (1u << i)) != 0)
+                _pageUses[i] = _uses;
+        }
+    }
+
+    void GlyphAtlas_Allegro::EvictPage()
+    {
+        if (_pages.empty())
+            return;
+
+        std::size_t index = 0;
+        for (std::size_t i = 1; i < _pages.size(); ++i)
+        {
+            if (_pageUses[i] < _pageUses[index])
+                index = i;
+        }
+
+        ALLEGRO_BITMAP* page = _pages[index];
+        const PiUInt32 mask = 1u << index;
+
+        for (auto&& entry : _fonts)
+        {
+            auto& glyphs = entry.second.glyphs;
+
+            for (auto it = glyphs.begin(); it != glyphs.end();)
+            {
+                if (it->second.page == page)
+                    it = glyphs.erase(it);
+                else
+                    ++it;
+            }
+
+            entry.second.runs.RemoveIf(
+                [mask](const GlyphRun& run)
+                {
+                    return (run.pages & mask) != 0;
+                });
+        }
+
+        ALLEGRO_STATE state;
+        al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+        al_set_target_bitmap(page);
+        al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+        al_restore_state(&state);
+
+        _packers[index].Clear();
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,258 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_GLYPH_ATLAS_H
+#define PIXEL_UI_GLYPH_ATLAS_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/AtlasPacker.h>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Rasterizes font glyphs once into shared atlas pages, and
+     * converts strings into cached glyph runs.
+     *
+     * Glyph runs are made of textured quads which can be submitted
+     * in a single batch, instead of drawing each string through Allegro.
+     */
+    class GlyphAtlas_Allegro
+    {
+    public:
+        /**
+         * @brief A single glyph of a run, positioned relatively to the run origin.
+         */
+        struct GlyphQuad
+        {
+            PiReal32 x1, y1, x2, y2;
+            PiReal32 u1, v1, u2, v2;
+            ALLEGRO_BITMAP* page;
+        };
+
+        /**
+         * @brief The cached geometry of a string.
+         */
+        struct GlyphRun
+        {
+            std::vector<GlyphQuad> quads;
+            PiReal32 width;
+            PiReal32 height;
+
+            // The atlas pages holding the glyphs of the run, as a bit mask of page indices.
+            PiUInt32 pages = 0;
+        };
+
+        /**
+         * @brief Caches the glyph runs of a font, and evicts the least recently used ones when full.
+         */
+        class RunCache
+        {
+        public:
+            /**
+             * @brief The default number of runs cached for a font.
+             */
+            static constexpr std::size_t kDefaultCapacity = 2048;
+
+            explicit RunCache(std::size_t capacity = kDefaultCapacity)
+                : _capacity(capacity)
+            {}
+
+            RunCache(const RunCache&) = delete;
+            RunCache& operator=(const RunCache&) = delete;
+
+            RunCache(RunCache&&) = default;
+            RunCache& operator=(RunCache&&) = default;
+
+            /**
+             * @brief Finds a cached run, and marks it as the most recently used.
+             *
+             * @return The run, or nullptr if it isn't cached.
+             */
+            GlyphRun* Find(const PiString& text)
+            {
+                auto it = _runs.find(text);
+                if (it == _runs.end())
+                    return nullptr;
+
+                _order.splice(_order.end(), _order, it->second.lru);
+                return &it->second.run;
+            }
+
+            /**
+             * @brief Caches a run which isn't cached yet, evicting the least recently used run if the cache is full.
+             */
+            GlyphRun& Add(const PiString& text, GlyphRun&& run)
+            {
+                if (_runs.size() >= _capacity && !_order.empty())
+                {
+                    const PiString oldest = *_order.front();
+                    _order.pop_front();
+                    _runs.erase(oldest);
+                }
+
+                auto it = _runs.emplace(text, CachedRun{ std::move(run), {} }).first;
+                it->second.lru = _order.insert(_order.end(), &it->first);
+
+                return it->second.run;
+            }
+
+            /**
+             * @brief Removes every run matching the given predicate.
+             */
+            template<typename Predicate>
+            void RemoveIf(Predicate&& predicate)
+            {
+                for (auto it = _runs.begin(); it != _runs.end();)
+                {
+                    if (predicate(it->second.run))
+                    {
+                        _order.erase(it->second.lru);
+                        it = _runs.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            void Clear()
+            {
+                _runs.clear();
+                _order.clear();
+            }
+
+        private:
+            struct CachedRun
+            {
+                GlyphRun run;
+                std::list<const PiString*>::iterator lru;
+            };
+
+            std::size_t _capacity;
+            std::unordered_map<PiString, CachedRun> _runs;
+
+            // The keys of the runs, from the least to the most recently used.
+            std::list<const PiString*> _order;
+        };
+
+        GlyphAtlas_Allegro();
+        ~GlyphAtlas_Allegro();
+
+        GlyphAtlas_Allegro(const GlyphAtlas_Allegro&) = delete;
+        GlyphAtlas_Allegro& operator=(const GlyphAtlas_Allegro&) = delete;
+
+        /**
+         * @brief Finds an already built glyph run.
+         *
+         * @param font The font used to draw the text.
+         * @param text The text to draw.
+         *
+         * @return The glyph run, or nullptr if the run has not been built yet.
+         */
+        [[nodiscard]] const GlyphRun* FindRun(ALLEGRO_FONT* font, const PiString& text);
+
+        /**
+         * @brief Builds and caches the glyph run of the given text.
+         *
+         * Missing glyphs are rasterized into the atlas pages, so this method
+         * changes the target bitmap. Any pending draw operation using the atlas
+         * pages must be flushed before calling it. When the atlas is full, the
+         * least recently used pages are cleared, along with the glyphs and runs
+         * using them.
+         *
+         * @param font The font used to draw the text.
+         * @param text The text to draw.
+         *
+         * @return The glyph run.
+         */
+        const GlyphRun& BuildRun(ALLEGRO_FONT* font, const PiString& text);
+
+        /**
+         * @brief Measures the width of the given text from the glyph advances.
+         *
+         * This method never rasterizes glyphs.
+         *
+         * @param font The font used to draw the text.
+         * @param text The text to measure.
+         *
+         * @return The width of the text, in pixels.
+         */
+        PiReal32 MeasureWidth(ALLEGRO_FONT* font, const PiString& text);
+
+        /**
+         * @brief Forgets every glyph and run cached for the given font.
+         *
+         * @param font The font to forget.
+         */
+        void Forget(ALLEGRO_FONT* font);
+
+        /**
+         * @brief Forgets every cached glyph and run, and clears the atlas pages.
+         */
+        void Clear();
+
+    private:
+        struct Glyph
+        {
+            ALLEGRO_BITMAP* page = nullptr;
+            PiInt32 x = 0, y = 0, w = 0, h = 0;
+            PiInt32 offsetX = 0, offsetY = 0;
+            PiInt32 advance = 0;
+            std::size_t pageIndex = 0;
+            bool rasterized = false;
+        };
+
+        struct FontEntry
+        {
+            std::unordered_map<PiInt32, Glyph> glyphs;
+            RunCache runs;
+        };
+
+        bool TryBuildRun(ALLEGRO_FONT* font, const PiString& text, GlyphRun& run);
+        Glyph& GetGlyph(FontEntry& entry, ALLEGRO_FONT* font, PiInt32 codepoint);
+        bool Rasterize(ALLEGRO_FONT* font, PiInt32 codepoint, Glyph& glyph);
+        bool Allocate(PiInt32 w, PiInt32 h, std::size_t& index, PiInt32& x, PiInt32& y);
+
+        /**
+         * @brief Marks the pages of the given bit mask as used by the latest run.
+         */
+        void TouchPages(PiUInt32 pages);
+
+        /**
+         * @brief Clears the least recently used page, and forgets the glyphs and runs using it.
+         */
+        void EvictPage();
+
+        std::unordered_map<ALLEGRO_FONT*, FontEntry> _fonts;
+        std::vector<ALLEGRO_BITMAP*> _pages;
+        std::vector<AtlasPacker> _packers;
+
+        // When each page was last used, and the current use count.
+        std::vector<PiUInt64> _pageUses;
+        PiUInt64 _uses;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_GLYPH_ATLAS_H
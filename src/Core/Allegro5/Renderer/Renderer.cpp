@@ -13,21 +13,64 @@
 // limitations under the License.
 
 #include <SparkyStudios/UI/Pixel/Core/Log.h>
+#include <SparkyStudios/UI/Pixel/Core/MainWindow.h>
+#include <SparkyStudios/UI/Pixel/Core/Platform.h>
 
 #include <Core/Allegro5/Renderer/Renderer.h>
+#include <Core/MappedFile.h>
 
 namespace SparkyStudios::UI::Pixel
 {
+    // The number of worker threads decoding textures loaded asynchronously.
+    static constexpr PiUInt32 kTextureDecoderCount = 2;
+
+    // The glyphs rasterized when a TrueType font is preloaded.
+    static constexpr const char* kPreloadGlyphs =
+        " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+    static Rect ScaleRegion(const Rect& region, PiReal32 scale)
+    {
+        const PiInt32 x = std::floor(static_cast<PiReal32>(region.x) * scale);
+        const PiInt32 y = std::floor(static_cast<PiReal32>(region.y) * scale);
+
+        return Rect(
+            x, y, std::ceil(static_cast<PiReal32>(region.x + region.w) * scale) - x,
+            std::ceil(static_cast<PiReal32>(region.y + region.h) * scale) - y);
+    }
+
     CacheToTexture_Allegro::CacheToTexture_Allegro()
-        : _oldTarget(nullptr)
+        : _renderer(nullptr)
+        , _oldTarget(nullptr)
+        , _budget(kDefaultBudget)
+        , _usedBytes(0)
+        , _frame(0)
+        , _allocations(0)
+        , _reuses(0)
+        , _evictions(0)
     {}
 
+    CacheToTexture_Allegro::~CacheToTexture_Allegro()
+    {
+        ShutDown();
+    }
+
     void CacheToTexture_Allegro::Initialize()
     {}
 
     void CacheToTexture_Allegro::ShutDown()
     {
-        // TODO: Delete cached textures
+        for (auto&& entry : _cache)
+        {
+            if (entry.second.m_bitmap != nullptr)
+                DestroyBitmap(entry.second.m_bitmap);
+        }
+
+        for (auto&& pooled : _pool)
+            DestroyBitmap(pooled.second);
+
+        _cache.clear();
+        _pool.clear();
+        _lru.clear();
     }
 
     void CacheToTexture_Allegro::SetupCacheTexture(CacheHandle control)
@@ -39,21 +82,32 @@ namespace SparkyStudios::UI::Pixel
         {
             // Prepare for rendering
             PI_ASSERT(_oldTarget == nullptr);
+            _renderer->Flush();
             _oldTarget = al_get_target_bitmap();
 
             auto* alBitmap = it->second.m_bitmap;
             PI_ASSERT(alBitmap != nullptr);
+
+            // Transformations are stored per bitmap, keep the UI scale while rendering in the cache.
+            ALLEGRO_TRANSFORM transform;
+            al_copy_transform(&transform, al_get_current_transform());
             al_set_target_bitmap(alBitmap);
+            al_use_transform(&transform);
 
-            al_clear_to_color(al_map_rgb_f(1.0f, 1.0f, 1.0f));
+            // Pooled bitmaps may hold another widget, and the widget may not cover all its bounds.
+            al_clear_to_color(al_map_rgba_f(0.0f, 0.0f, 0.0f, 0.0f));
         }
     }
 
     void CacheToTexture_Allegro::FinishCacheTexture(CacheHandle control)
     {
         // Prepare for rendering
+        _renderer->Flush();
         al_set_target_bitmap(_oldTarget);
         _oldTarget = nullptr;
+
+        if (CacheMap::iterator it = _cache.find(control); it != _cache.end())
+            it->second.m_valid = true;
     }
 
     void CacheToTexture_Allegro::SetRenderer(BaseRenderer* renderer)
@@ -66,64 +120,389 @@ namespace SparkyStudios::UI::Pixel
         CacheMap::iterator it = _cache.find(control);
         PI_ASSERT(it != _cache.end());
 
-        if (it != _cache.end())
+        // A pooled bitmap may still hold the image of another widget until it is rendered.
+        if (it != _cache.end() && it->second.m_valid)
         {
-            auto* alBitmap = it->second.m_bitmap;
+            CacheEntry& entry = it->second;
+            entry.m_lastUsedFrame = _frame;
+            _lru.splice(_lru.begin(), _lru, entry.m_lru);
+
+            // The bitmap has been rendered at the UI scale, draw its pixels as they are.
+            const PiReal32 scale = _renderer->GetScale();
             const Point& offset = _renderer->GetRenderOffset();
-            al_draw_bitmap(alBitmap, offset.x, offset.y, 0);
+            _renderer->Flush();
+
+            ALLEGRO_TRANSFORM transform;
+            ALLEGRO_TRANSFORM identity;
+            al_copy_transform(&transform, al_get_current_transform());
+            al_identity_transform(&identity);
+            al_use_transform(&identity);
+
+            al_draw_bitmap_region(
+                entry.m_bitmap, 0, 0, std::ceil(static_cast<PiReal32>(entry.m_size.w) * scale),
+                std::ceil(static_cast<PiReal32>(entry.m_size.h) * scale), std::floor(static_cast<PiReal32>(offset.x) * scale),
+                std::floor(static_cast<PiReal32>(offset.y) * scale), 0);
+
+            al_use_transform(&transform);
         }
     }
 
-    void CacheToTexture_Allegro::CreateWidgetCacheTexture(CacheHandle control, const Size& size)
+    bool CacheToTexture_Allegro::CreateWidgetCacheTexture(CacheHandle control, const Size& size)
     {
-        // If we haven't seen this control before, create a new one
-        if (_cache.find(control) == _cache.end())
+        if (size.w <= 0 || size.h <= 0)
         {
-            al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
-            CacheEntry newEntry = { al_create_bitmap(size.w, size.h) };
-            _cache[control] = newEntry;
+            FreeWidgetCacheTexture(control);
+            return false;
         }
+
+        const std::pair<PiInt32, PiInt32> bucket = GetBucket(size);
+        CacheMap::iterator it = _cache.find(control);
+
+        if (it != _cache.end())
+        {
+            CacheEntry& entry = it->second;
+
+            if (entry.m_size.w != size.w || entry.m_size.h != size.h || entry.m_scale != _renderer->GetScale())
+            {
+                entry.m_size = size;
+                entry.m_scale = _renderer->GetScale();
+                entry.m_valid = false;
+            }
+
+            entry.m_lastUsedFrame = _frame;
+            _lru.splice(_lru.begin(), _lru, entry.m_lru);
+
+            if (al_get_bitmap_width(entry.m_bitmap) == bucket.first && al_get_bitmap_height(entry.m_bitmap) == bucket.second)
+                return true;
+
+            // The widget has been resized or the UI scale has changed, another bitmap is needed.
+            ALLEGRO_BITMAP* bitmap = entry.m_bitmap;
+            _lru.erase(entry.m_lru);
+            _cache.erase(it);
+            ReleaseBitmap(bitmap);
+        }
+
+        ALLEGRO_BITMAP* bitmap = AcquireBitmap(bucket);
+
+        if (bitmap == nullptr)
+            return false;
+
+        CacheEntry& entry = _cache[control];
+        entry.m_bitmap = bitmap;
+        entry.m_size = size;
+        entry.m_scale = _renderer->GetScale();
+        entry.m_valid = false;
+        entry.m_lastUsedFrame = _frame;
+        entry.m_lru = _lru.insert(_lru.begin(), control);
+
+        return true;
+    }
+
+    void CacheToTexture_Allegro::FreeWidgetCacheTexture(CacheHandle control)
+    {
+        CacheMap::iterator it = _cache.find(control);
+
+        if (it == _cache.end())
+            return;
+
+        ALLEGRO_BITMAP* bitmap = it->second.m_bitmap;
+        _lru.erase(it->second.m_lru);
+        _cache.erase(it);
+        ReleaseBitmap(bitmap);
+    }
+
+    bool CacheToTexture_Allegro::IsWidgetCacheTextureValid(CacheHandle control) const
+    {
+        CacheMap::const_iterator it = _cache.find(control);
+        return it != _cache.end() && it->second.m_valid;
     }
 
     void CacheToTexture_Allegro::UpdateWidgetCacheTexture(CacheHandle control)
     {}
 
+    void CacheToTexture_Allegro::SetBudget(PiUInt64 bytes)
+    {
+        _budget = bytes;
+        MakeRoom(0);
+    }
+
+    PiUInt64 CacheToTexture_Allegro::GetBudget() const
+    {
+        return _budget;
+    }
+
+    ICacheToTexture::Stats CacheToTexture_Allegro::GetStats() const
+    {
+        Stats stats;
+        stats.entries = _cache.size();
+        stats.pooled = _pool.size();
+        stats.usedBytes = _usedBytes;
+        stats.budgetBytes = _budget;
+        stats.allocations = _allocations;
+        stats.reuses = _reuses;
+        stats.evictions = _evictions;
+
+        return stats;
+    }
+
+    void CacheToTexture_Allegro::NewFrame()
+    {
+        _frame++;
+    }
+
+    std::pair<PiInt32, PiInt32> CacheToTexture_Allegro::GetBucket(const Size& size) const
+    {
+        // Rounding up the sizes lets bitmaps be reused by widgets of similar sizes,
+        // and avoids reallocations while a widget is resized.
+        constexpr PiInt32 kGranularity = 32;
+
+        const PiReal32 scale = _renderer->GetScale();
+        const auto w = static_cast<PiInt32>(std::ceil(static_cast<PiReal32>(size.w) * scale));
+        const auto h = static_cast<PiInt32>(std::ceil(static_cast<PiReal32>(size.h) * scale));
+
+        return { (w + kGranularity - 1) / kGranularity * kGranularity, (h + kGranularity - 1) / kGranularity * kGranularity };
+    }
+
+    ALLEGRO_BITMAP* CacheToTexture_Allegro::AcquireBitmap(const std::pair<PiInt32, PiInt32>& bucket)
+    {
+        if (BitmapPool::iterator it = _pool.find(bucket); it != _pool.end())
+        {
+            ALLEGRO_BITMAP* bitmap = it->second;
+            _pool.erase(it);
+            _reuses++;
+
+            return bitmap;
+        }
+
+        const PiUInt64 bytes = static_cast<PiUInt64>(bucket.first) * bucket.second * 4;
+
+        if (!MakeRoom(bytes))
+            return nullptr;
+
+        const int flags = al_get_new_bitmap_flags();
+        al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
+        ALLEGRO_BITMAP* bitmap = al_create_bitmap(bucket.first, bucket.second);
+        al_set_new_bitmap_flags(flags);
+
+        if (bitmap == nullptr)
+        {
+            Log::Write(Log::Level::Error, "Unable to create a %dx%d widget cache texture.", bucket.first, bucket.second);
+            return nullptr;
+        }
+
+        _usedBytes += bytes;
+        _allocations++;
+
+        return bitmap;
+    }
+
+    void CacheToTexture_Allegro::ReleaseBitmap(ALLEGRO_BITMAP* bitmap)
+    {
+        if (_usedBytes > _budget)
+        {
+            DestroyBitmap(bitmap);
+            return;
+        }
+
+        _pool.emplace(std::make_pair(al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap)), bitmap);
+    }
+
+    bool CacheToTexture_Allegro::MakeRoom(PiUInt64 bytes)
+    {
+        while (_usedBytes + bytes > _budget && !_pool.empty())
+        {
+            DestroyBitmap(_pool.begin()->second);
+            _pool.erase(_pool.begin());
+        }
+
+        // Evict the least recently used widgets, but never the ones drawn in this frame.
+        while (_usedBytes + bytes > _budget && !_lru.empty())
+        {
+            CacheMap::iterator it = _cache.find(_lru.back());
+            PI_ASSERT(it != _cache.end());
+
+            if (it->second.m_lastUsedFrame == _frame)
+                return false;
+
+            DestroyBitmap(it->second.m_bitmap);
+            _lru.pop_back();
+            _cache.erase(it);
+            _evictions++;
+        }
+
+        return _usedBytes + bytes <= _budget;
+    }
+
+    void CacheToTexture_Allegro::DestroyBitmap(ALLEGRO_BITMAP* bitmap)
+    {
+        _usedBytes -= static_cast<PiUInt64>(al_get_bitmap_width(bitmap)) * al_get_bitmap_height(bitmap) * 4;
+        al_destroy_bitmap(bitmap);
+    }
+
     Renderer_Allegro::Renderer_Allegro(ResourcePaths& paths)
         : BaseRenderer(paths)
-        , _lastFont(nullptr)
-        , _lastTexture(nullptr)
+        , _textureBytes(0)
+        , _textureBudget(kDefaultTextureBudget)
+        , _textureEvictions(0)
+        , _frame(0)
+        , _frameTime(0)
+        , _fontScale(1.0f)
+        , _retiringFonts(false)
+        , _hasDrawColor(false)
+        , _clipTarget(nullptr)
+        , _transformTarget(nullptr)
+        , _transformScale(1.0f)
         , _ctt(new CacheToTexture_Allegro())
+        , _decoders(nullptr)
+        , _lastRequest(0)
+        , _memoryBitmaps(false)
     {
         _ctt->SetRenderer(this);
         _ctt->Initialize();
     }
 
     Renderer_Allegro::~Renderer_Allegro()
-    {}
+    {
+        // Wait for the running decodes, then drop their results.
+        delete _decoders;
+
+        for (auto&& result : _decoded)
+        {
+            if (result.bitmap != nullptr)
+                al_destroy_bitmap(result.bitmap);
+        }
+
+        _ctt->ShutDown();
+        delete _ctt;
+    }
+
+    void Renderer_Allegro::Begin()
+    {
+        BaseRenderer::Begin();
+        _ctt->NewFrame();
+        _frame++;
+        _frameTime = Platform::GetTimeInSeconds();
+
+        UploadDecodedTextures();
+        RetireFonts();
+
+        // Textures drawn in the previous frame can be evicted again.
+        EvictTextures();
+    }
+
+    void Renderer_Allegro::Flush()
+    {
+        if (_batch.IsEmpty())
+            return;
+
+        m_frameStats.drawCalls += _batch.Flush();
+        m_frameStats.flushes++;
+    }
+
+    void Renderer_Allegro::PrepareBatch(ALLEGRO_BITMAP* texture, std::size_t vertexCount)
+    {
+        m_frameStats.primitives++;
+
+        if (!_batch.CanAppend(texture, vertexCount))
+            Flush();
+    }
+
+    void Renderer_Allegro::PrepareImmediate()
+    {
+        Flush();
+
+        m_frameStats.primitives++;
+        m_frameStats.drawCalls++;
+    }
+
+    void Renderer_Allegro::ApplyTransform()
+    {
+        ALLEGRO_BITMAP* target = al_get_target_bitmap();
+
+        if (target == _transformTarget && GetScale() == _transformScale)
+        {
+            m_frameStats.elidedStateChanges++;
+            return;
+        }
+
+        Flush();
+
+        ALLEGRO_TRANSFORM transform;
+        al_identity_transform(&transform);
+        al_scale_transform(&transform, GetScale(), GetScale());
+        al_use_transform(&transform);
+
+        _transformTarget = target;
+        _transformScale = GetScale();
+        m_frameStats.stateChanges++;
+    }
+
+    void Renderer_Allegro::ApplyClip(const Rect& rect)
+    {
+        ALLEGRO_BITMAP* target = al_get_target_bitmap();
+
+        // The clipping rectangle is stored per bitmap, so it only needs to be set again when the target changes.
+        if (target == _clipTarget && rect == _clipRect)
+        {
+            m_frameStats.elidedStateChanges++;
+            return;
+        }
+
+        Flush();
+        al_set_clipping_rectangle(rect.x, rect.y, rect.w, rect.h);
+
+        _clipTarget = target;
+        _clipRect = rect;
+        m_frameStats.stateChanges++;
+    }
 
     void Renderer_Allegro::SetDrawColor(const Color& color)
     {
+        if (_hasDrawColor && color == _drawColor)
+        {
+            m_frameStats.elidedStateChanges++;
+            return;
+        }
+
         _color = al_map_rgba(color.r, color.g, color.b, color.a);
+        _drawColor = color;
+        _hasDrawColor = true;
+        m_frameStats.stateChanges++;
     }
 
     void Renderer_Allegro::StartClip()
     {
-        Rect rect = ClipRegion();
-        al_set_clipping_rectangle(rect.x, rect.y, rect.w, rect.h);
+        ApplyTransform();
+
+        // Clipping rectangles are not transformed by Allegro.
+        const Rect& rect = ClipRegion();
+
+        if (rect.w <= 0 || rect.h <= 0)
+            ApplyClip(Rect(0, 0, 0, 0));
+        else
+            ApplyClip(ScaleRegion(rect, GetScale()));
     }
 
     void Renderer_Allegro::EndClip()
     {
+        ApplyTransform();
+
         ALLEGRO_BITMAP* target = al_get_target_bitmap();
-        al_set_clipping_rectangle(0, 0, al_get_bitmap_width(target), al_get_bitmap_height(target));
+
+        // Partial frames must never draw outside of the damaged region.
+        if (!_frameRegion.IsEmpty() && al_get_current_display() != nullptr && target == al_get_backbuffer(al_get_current_display()))
+            ApplyClip(_frameRegion);
+        else
+            ApplyClip(Rect(0, 0, al_get_bitmap_width(target), al_get_bitmap_height(target)));
     }
 
     Color Renderer_Allegro::PixelColor(const Texture& texture, const Point& position, const Color& col_default)
     {
-        if (!EnsureTexture(texture))
+        TextureEntry* entry = ResolveTexture(texture);
+        if (entry == nullptr)
             return col_default;
 
-        TextureData_Allegro& data = _lastTexture->second;
+        TextureData_Allegro& data = entry->second;
         ALLEGRO_COLOR color = al_get_pixel(data.texture.get(), position.x, position.y);
 
         Color c;
@@ -135,13 +514,35 @@ namespace SparkyStudios::UI::Pixel
     void Renderer_Allegro::DrawFilledRect(Rect rect, const Size& radii)
     {
         Translate(rect);
-        const PiReal32 fx = rect.x + 0.5f, fy = rect.y + 0.5f;
-        al_draw_filled_rounded_rectangle(fx, fy, fx + rect.w, fy + rect.h, radii.w, radii.h, _color);
+
+        // Edges lie between pixel centers, even once scaled, so no half pixel offset is needed.
+        const PiReal32 x1 = rect.x, y1 = rect.y, x2 = rect.x + rect.w, y2 = rect.y + rect.h;
+
+        if (IsBatchingEnabled() && radii.w == 0 && radii.h == 0)
+        {
+            PrepareBatch(nullptr, 4);
+            _batch.AddRect(x1, y1, x2, y2, _color);
+            return;
+        }
+
+        if (IsBatchingEnabled())
+        {
+            const auto& geometry =
+                _shapes.Get(ShapeCache_Allegro::Shape::FilledRoundedRect, rect.w, rect.h, radii.w, radii.h, 0.0f, GetScale());
+
+            PrepareBatch(nullptr, geometry.vertices.size());
+            _batch.AddGeometry(geometry, x1, y1, _color);
+            return;
+        }
+
+        PrepareImmediate();
+        al_draw_filled_rounded_rectangle(x1, y1, x2, y2, radii.w, radii.h, _color);
     }
 
     void Renderer_Allegro::DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2)
     {
-        if (!EnsureTexture(texture))
+        TextureEntry* entry = ResolveTexture(texture);
+        if (entry == nullptr)
         {
             DrawMissingImage(rect);
             return;
@@ -149,11 +550,26 @@ namespace SparkyStudios::UI::Pixel
 
         Translate(rect);
 
-        TextureData_Allegro& data = _lastTexture->second;
+        TextureData_Allegro& data = entry->second;
 
         const PiUInt32 w = data.width;
         const PiUInt32 h = data.height;
 
+        if (IsBatchingEnabled())
+        {
+            // Packed textures are drawn from their atlas page, so they can share batches.
+            ALLEGRO_BITMAP* bitmap = data.page != nullptr ? data.page : data.texture.get();
+            const PiReal32 x = data.region.x, y = data.region.y;
+
+            // Textures are drawn untinted, the same way al_draw_scaled_bitmap does.
+            PrepareBatch(bitmap, 4);
+            _batch.AddQuad(
+                rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, x + u1 * w, y + v1 * h, x + u2 * w, y + v2 * h, al_map_rgb(255, 255, 255),
+                bitmap);
+            return;
+        }
+
+        PrepareImmediate();
         al_draw_scaled_bitmap(
             data.texture.get(), // texture
             u1 * w, v1 * h, (u2 - u1) * w, (v2 - v1) * h, // source
@@ -165,6 +581,33 @@ namespace SparkyStudios::UI::Pixel
     void Renderer_Allegro::DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii)
     {
         Translate(rect);
+
+        if (IsBatchingEnabled() && radii.w == 0 && radii.h == 0)
+        {
+            // A thickness of 0 means a hairline in Allegro, which covers a single pixel whatever the scale.
+            const PiReal32 t = thickness > 0 ? thickness : 1.0f / GetScale();
+            const PiReal32 x1 = rect.x, y1 = rect.y, x2 = rect.x + rect.w, y2 = rect.y + rect.h;
+
+            PrepareBatch(nullptr, 16);
+            _batch.AddRect(x1, y1, x2, y1 + t, _color); // top
+            _batch.AddRect(x1, y2 - t, x2, y2, _color); // bottom
+            _batch.AddRect(x1, y1 + t, x1 + t, y2 - t, _color); // left
+            _batch.AddRect(x2 - t, y1 + t, x2, y2 - t, _color); // right
+            return;
+        }
+
+        if (IsBatchingEnabled())
+        {
+            const PiReal32 t = thickness > 0 ? thickness : 1.0f / GetScale();
+            const auto& geometry =
+                _shapes.Get(ShapeCache_Allegro::Shape::LinedRoundedRect, rect.w, rect.h, radii.w, radii.h, t, GetScale());
+
+            PrepareBatch(nullptr, geometry.vertices.size());
+            _batch.AddGeometry(geometry, rect.x, rect.y, _color);
+            return;
+        }
+
+        PrepareImmediate();
         const PiReal32 offset = (thickness * 0.5f), fx = rect.x + offset, fy = rect.y + offset;
         al_draw_rounded_rectangle(fx, fy, fx + rect.w - thickness, fy + rect.h - thickness, radii.w, radii.h, _color, thickness);
     }
@@ -172,6 +615,17 @@ namespace SparkyStudios::UI::Pixel
     void Renderer_Allegro::DrawFilledEllipse(Rect rect)
     {
         Translate(rect);
+
+        if (IsBatchingEnabled())
+        {
+            const auto& geometry = _shapes.Get(ShapeCache_Allegro::Shape::FilledEllipse, rect.w, rect.h, 0.0f, 0.0f, 0.0f, GetScale());
+
+            PrepareBatch(nullptr, geometry.vertices.size());
+            _batch.AddGeometry(geometry, rect.x, rect.y, _color);
+            return;
+        }
+
+        PrepareImmediate();
         if (rect.w == rect.h)
             al_draw_filled_circle(rect.x + (rect.w / 2), rect.y + (rect.h / 2), rect.w / 2, _color);
         else
@@ -181,6 +635,18 @@ namespace SparkyStudios::UI::Pixel
     void Renderer_Allegro::DrawLinedEllipse(Rect rect, PiUInt32 thickness)
     {
         Translate(rect);
+
+        if (IsBatchingEnabled())
+        {
+            const PiReal32 t = thickness > 0 ? thickness : 1.0f / GetScale();
+            const auto& geometry = _shapes.Get(ShapeCache_Allegro::Shape::LinedEllipse, rect.w, rect.h, 0.0f, 0.0f, t, GetScale());
+
+            PrepareBatch(nullptr, geometry.vertices.size());
+            _batch.AddGeometry(geometry, rect.x, rect.y, _color);
+            return;
+        }
+
+        PrepareImmediate();
         if (rect.w == rect.h)
             al_draw_circle(rect.x + (rect.w / 2), rect.y + (rect.h / 2), rect.w / 2, _color, thickness);
         else
@@ -192,6 +658,15 @@ namespace SparkyStudios::UI::Pixel
         Translate(p1.x, p1.y);
         Translate(p2.x, p2.y);
         Translate(p3.x, p3.y);
+
+        if (IsBatchingEnabled())
+        {
+            PrepareBatch(nullptr, 3);
+            _batch.AddTriangle(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, _color);
+            return;
+        }
+
+        PrepareImmediate();
         al_draw_filled_triangle(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, _color);
     }
 
@@ -200,11 +675,14 @@ namespace SparkyStudios::UI::Pixel
         Translate(p1.x, p1.y);
         Translate(p2.x, p2.y);
         Translate(p3.x, p3.y);
+        PrepareImmediate();
         al_draw_triangle(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, _color, thickness);
     }
 
     void Renderer_Allegro::DrawShavedCornerRect(Rect rect, bool slight)
     {
+        Translate(rect);
+
         // Draw INSIDE the w/h.
         rect.w -= 1;
         rect.h -= 1;
@@ -214,9 +692,13 @@ namespace SparkyStudios::UI::Pixel
     SET_VERT(I, X0, Y0);                                                                                                                   \
     SET_VERT(I + 1, X1, Y1)
 
-        const PiReal32 fx = rect.x + 0.5f, fy = rect.y + 0.5f;
+        // Lines are drawn through pixel centers.
+        const PiReal32 half = 0.5f / GetScale();
+        const PiReal32 fx = rect.x + half, fy = rect.y + half;
         const PiReal32 fw = rect.w, fh = rect.h;
 
+        PrepareImmediate();
+
         if (slight)
         {
             ALLEGRO_VERTEX vtx[4 * 2];
@@ -242,31 +724,95 @@ namespace SparkyStudios::UI::Pixel
 
     void Renderer_Allegro::DrawString(const Font& font, Point pos, const PiString& text)
     {
-        if (!EnsureFont(font))
+        FontEntry* entry = ResolveFont(font);
+        if (entry == nullptr)
             return;
 
-        auto it = _fonts.find(font);
-        if (it == _fonts.end())
+        FontData_Allegro& data = entry->second;
+        Translate(pos.x, pos.y);
+
+        // Fonts are rasterized at the scaled size, so glyphs are placed on the pixel grid and kept unscaled.
+        const PiReal32 scale = GetScale();
+        const PiReal32 px = std::round(pos.x * scale), py = std::round(pos.y * scale);
+
+        if (!IsBatchingEnabled())
+        {
+            PrepareImmediate();
+
+            ALLEGRO_TRANSFORM transform, identity;
+            al_copy_transform(&transform, al_get_current_transform());
+            al_identity_transform(&identity);
+            al_use_transform(&identity);
+
+            if (data.baked != nullptr)
+            {
+                for (const auto& quad : data.baked->BuildRun(text).quads)
+                {
+                    al_draw_tinted_bitmap_region(
+                        quad.page, _color, quad.u1, quad.v1, quad.u2 - quad.u1, quad.v2 - quad.v1, px + quad.x1, py + quad.y1, 0);
+                }
+            }
+            else
+            {
+                al_draw_text(data.font.get(), _color, px, py, ALLEGRO_ALIGN_LEFT, text.c_str());
+            }
+
+            al_use_transform(&transform);
             return;
+        }
 
-        FontData_Allegro& data = it->second;
-        Translate(pos.x, pos.y);
+        // Baked fonts have all their glyphs in their own atlas bitmap.
+        const GlyphAtlas_Allegro::GlyphRun* run =
+            data.baked != nullptr ? &data.baked->BuildRun(text) : _glyphs.FindRun(data.font.get(), text);
 
-        al_draw_text(data.font.get(), _color, pos.x, pos.y, ALLEGRO_ALIGN_LEFT, text.c_str());
+        if (run == nullptr)
+        {
+            // Building the run may rasterize glyphs into atlas pages used by the pending geometry.
+            Flush();
+            run = &_glyphs.BuildRun(data.font.get(), text);
+        }
+
+        m_frameStats.primitives++;
+
+        const PiReal32 inv = 1.0f / scale;
+
+        for (const auto& quad : run->quads)
+        {
+            if (!_batch.CanAppend(quad.page, 4))
+                Flush();
+
+            _batch.AddQuad(
+                (px + quad.x1) * inv, (py + quad.y1) * inv, (px + quad.x2) * inv, (py + quad.y2) * inv, quad.u1, quad.v1, quad.u2, quad.v2,
+                _color, quad.page);
+        }
     }
 
     Size Renderer_Allegro::MeasureText(const Font& font, const PiString& text)
     {
-        if (!EnsureFont(font))
+        const FontEntry* entry = ResolveFont(font);
+        if (entry == nullptr)
             return Size(0, 0);
 
-        auto it = _fonts.find(font);
-        if (it == _fonts.end())
-            return Size(0, 0);
+        const FontData_Allegro& data = entry->second;
+        const auto handle = data.GetHandle();
 
-        FontData_Allegro& data = it->second;
+        // The font is rasterized at the scaled size, while text is laid out in render space.
+        const PiReal32 scale = GetScale();
 
-        return Size(al_get_text_width(data.font.get(), text.c_str()), al_get_font_line_height(data.font.get()));
+        Size size;
+        if (!m_measureCache.Find(handle, text, size))
+        {
+            // Measuring may cache glyphs in font bitmaps.
+            TrackMemoryBitmaps();
+
+            if (data.baked != nullptr)
+                size = Size(data.baked->MeasureWidth(text), data.baked->GetLineHeight());
+            else
+                size = Size(_glyphs.MeasureWidth(data.font.get(), text), al_get_font_line_height(data.font.get()));
+            m_measureCache.Insert(handle, text, size);
+        }
+
+        return Size(std::ceil(size.w / scale), std::ceil(size.h / scale));
     }
 
     bool Renderer_Allegro::InitializeContext(MainWindow* window)
@@ -286,6 +832,37 @@ namespace SparkyStudios::UI::Pixel
 
     bool Renderer_Allegro::BeginContext(MainWindow* window)
     {
+        // Bitmaps loaded by another thread have no display to live on, upload them now.
+        ConvertMemoryBitmaps();
+
+        // The backbuffer may have been resized or clipped by a partial frame.
+        _clipTarget = nullptr;
+        _transformTarget = nullptr;
+        _frameRegion = Rect();
+
+        EndClip();
+        al_clear_to_color(al_map_rgba_f(0.0f, 0.0f, 0.0f, 0.0f));
+        return true;
+    }
+
+    bool Renderer_Allegro::BeginContext(MainWindow* window, const Rect& region)
+    {
+        ConvertMemoryBitmaps();
+
+        if (region.IsEmpty())
+        {
+            _clipTarget = nullptr;
+            _transformTarget = nullptr;
+            _frameRegion = Rect();
+            return true;
+        }
+
+        _clipTarget = nullptr;
+        _transformTarget = nullptr;
+        _frameRegion = ScaleRegion(region, GetScale());
+
+        // Only clear the damaged region, the rest of the backbuffer is kept from the previous frame.
+        EndClip();
         al_clear_to_color(al_map_rgba_f(0.0f, 0.0f, 0.0f, 0.0f));
         return true;
     }
@@ -297,10 +874,53 @@ namespace SparkyStudios::UI::Pixel
 
     bool Renderer_Allegro::PresentContext(MainWindow* window)
     {
+        Flush();
         al_flip_display();
         return true;
     }
 
+    bool Renderer_Allegro::PresentContext(MainWindow* window, const Rect& region)
+    {
+        Flush();
+
+        if (!region.IsEmpty())
+        {
+            const Rect pixels = ScaleRegion(region, GetScale());
+            al_update_display_region(pixels.x, pixels.y, pixels.w, pixels.h);
+        }
+
+        _frameRegion = Rect();
+        return true;
+    }
+
+    bool Renderer_Allegro::CanPresentRegion(MainWindow* window)
+    {
+        auto* display = static_cast<ALLEGRO_DISPLAY*>(window->GetNativeHandle());
+
+        if (display == nullptr)
+            return false;
+
+        return al_get_display_option(display, ALLEGRO_UPDATE_DISPLAY_REGION) != 0 &&
+            al_get_display_option(display, ALLEGRO_SWAP_METHOD) == 1;
+    }
+
+    void Renderer_Allegro::ConvertMemoryBitmapsLater()
+    {
+        _memoryBitmaps = true;
+    }
+
+    void Renderer_Allegro::TrackMemoryBitmaps()
+    {
+        if (al_get_current_display() == nullptr)
+            _memoryBitmaps = true;
+    }
+
+    void Renderer_Allegro::ConvertMemoryBitmaps()
+    {
+        if (_memoryBitmaps.exchange(false))
+            al_convert_memory_bitmaps();
+    }
+
     ICacheToTexture* Renderer_Allegro::GetCTT()
     {
         return _ctt;
@@ -308,12 +928,47 @@ namespace SparkyStudios::UI::Pixel
 
     IResourceLoader::LoadStatus Renderer_Allegro::LoadFont(const Font& font)
     {
-        FreeFont(font);
-        _lastFont = nullptr;
+        FreeScaledFont(ScaledFont(font, GetFontPixelSize(font)));
+
+        return AddFont(font, LoadBakedFont(font));
+    }
+
+    IResourceLoader::LoadStatus Renderer_Allegro::AddFont(const Font& font, BakedFont_Allegro* baked)
+    {
+        TrackMemoryBitmaps();
+
+        const ScaledFont key(font, GetFontPixelSize(font));
+
+        // Baked fonts are preferred, they don't need to be rasterized.
+        if (baked != nullptr)
+        {
+            baked->Upload();
+
+            FontData_Allegro fontData;
+            fontData.baked.reset(baked);
+
+            _fonts.Insert(key, std::move(fontData));
+            font.handle = key.handle;
+
+            return LoadStatus::Loaded;
+        }
 
         const PiString fileName = GetResourcePaths().GetPath(ResourcePaths::Type::Font, font.facename);
 
-        ALLEGRO_FONT* alFont = al_load_font(fileName.c_str(), font.size * GetScale(), ALLEGRO_TTF_NO_KERNING);
+        const void* data = nullptr;
+        PiUInt64 size = 0;
+        ALLEGRO_FONT* alFont = nullptr;
+
+        if (GetResourcePaths().GetData(ResourcePaths::Type::Font, font.facename, data, size))
+        {
+            // The font owns the memory file, and reads it as glyphs are rendered.
+            if (ALLEGRO_FILE* file = al_open_memfile(const_cast<void*>(data), static_cast<int64_t>(size), "r"); file != nullptr)
+                alFont = al_load_ttf_font_f(file, fileName.c_str(), key.pixelSize, ALLEGRO_TTF_NO_KERNING);
+        }
+        else
+        {
+            alFont = al_load_font(fileName.c_str(), key.pixelSize, ALLEGRO_TTF_NO_KERNING);
+        }
 
         if (alFont != nullptr)
         {
@@ -326,7 +981,9 @@ namespace SparkyStudios::UI::Pixel
                         al_destroy_font(f);
                 });
 
-            _lastFont = &(*_fonts.insert({ font, std::move(fontData) }).first);
+            _fonts.Insert(key, std::move(fontData));
+            font.handle = key.handle;
+
             return LoadStatus::Loaded;
         }
         else
@@ -336,40 +993,252 @@ namespace SparkyStudios::UI::Pixel
         }
     }
 
+    BakedFont_Allegro* Renderer_Allegro::LoadBakedFont(const Font& font)
+    {
+        // Baked fonts are named after the TrueType font, with the .pifn extension.
+        PiString name = font.facename;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".ttf") == 0)
+            name.erase(name.size() - 4);
+
+        name += ".pifn";
+
+        // The same pixel size as the TrueType font would be rasterized at.
+        const auto pixelSize = static_cast<PiInt32>(GetFontPixelSize(font));
+
+        const void* data = nullptr;
+        PiUInt64 size = 0;
+
+        if (GetResourcePaths().GetData(ResourcePaths::Type::Other, name, data, size))
+            return BakedFont_Allegro::Load(data, size, pixelSize);
+
+        MappedFile file;
+        if (!file.Open(GetResourcePaths().GetPath(ResourcePaths::Type::Other, name)))
+            return nullptr;
+
+        return BakedFont_Allegro::Load(file.GetData(), file.GetSize(), pixelSize);
+    }
+
     void Renderer_Allegro::FreeFont(const Font& font)
     {
-        if (_lastFont != nullptr && _lastFont->first == font)
-            _lastFont = nullptr;
+        // The font may be loaded at several scales.
+        std::vector<ScaledFont> scaled;
+        _fonts.ForEach(
+            [&font, &scaled](const FontEntry& entry)
+            {
+                if (entry.first.font == font)
+                    scaled.push_back(entry.first);
+            });
+
+        for (auto&& key : scaled)
+            FreeScaledFont(key);
+    }
+
+    void Renderer_Allegro::FreeScaledFont(const ScaledFont& font)
+    {
+        const FontEntry* entry = _fonts.Find(font);
+        if (entry == nullptr)
+            return;
+
+        if (entry->second.font != nullptr)
+            _glyphs.Forget(entry->second.font.get());
+
+        m_measureCache.Invalidate(entry->second.GetHandle());
+        _fonts.Erase(font);
+    }
+
+    void Renderer_Allegro::RetireFonts()
+    {
+        if (GetScale() != _fontScale)
+        {
+            _fontScale = GetScale();
+            _retiringFonts = true;
+        }
+
+        if (!_retiringFonts)
+            return;
+
+        // Fonts at another pixel size than the current scale gives are kept while they are still drawn,
+        // eg. by a cached widget texture rendered at the previous scale.
+        std::vector<ScaledFont> retired;
+        bool remaining = false;
+
+        _fonts.ForEach(
+            [this, &retired, &remaining](const FontEntry& entry)
+            {
+                if (entry.first.pixelSize == GetFontPixelSize(entry.first.font))
+                    return;
+
+                if (_frameTime - entry.second.lastUsedTime >= kFontRetireDelay)
+                    retired.push_back(entry.first);
+                else
+                    remaining = true;
+            });
+
+        for (auto&& key : retired)
+            FreeScaledFont(key);
+
+        _retiringFonts = remaining;
+    }
+
+    PiUInt32 Renderer_Allegro::GetFontPixelSize(const Font& font) const
+    {
+        // Fonts are rasterized at whole pixel sizes.
+        return static_cast<PiUInt32>(font.size * GetScale());
+    }
+
+    Renderer_Allegro::FontEntry* Renderer_Allegro::FindFont(const Font& font)
+    {
+        const PiUInt32 pixelSize = GetFontPixelSize(font);
+
+        // The handle interned by the last lookup, unless the font was then at another scale.
+        if (FontEntry* entry = _fonts.Get(font.handle);
+            entry != nullptr && entry->first.pixelSize == pixelSize && entry->first.font == font)
+            return entry;
 
-        _fonts.erase(font);
+        const ScaledFont key(font, pixelSize);
+        FontEntry* entry = _fonts.Find(key);
+
+        if (entry != nullptr)
+            font.handle = key.handle;
+
+        return entry;
     }
 
     bool Renderer_Allegro::EnsureFont(const Font& font)
     {
-        if (_lastFont != nullptr && _lastFont->first == font)
-            return true;
+        return ResolveFont(font) != nullptr;
+    }
+
+    Renderer_Allegro::FontEntry* Renderer_Allegro::ResolveFont(const Font& font)
+    {
+        FontEntry* entry = FindFont(font);
 
-        auto it = _fonts.find(font);
-        if (it != _fonts.end())
+        if (entry == nullptr)
         {
-            _lastFont = &(*it);
-            return true;
+            if (LoadFont(font) != IResourceLoader::LoadStatus::Loaded)
+                return nullptr;
+
+            entry = FindFont(font);
         }
 
-        return LoadFont(font) == IResourceLoader::LoadStatus::Loaded;
+        entry->second.lastUsedTime = _frameTime;
+        return entry;
     }
 
     IResourceLoader::LoadStatus Renderer_Allegro::LoadTexture(const Texture& texture)
     {
         FreeTexture(texture);
-        _lastTexture = nullptr;
         const PiString fileName = GetResourcePaths().GetPath(ResourcePaths::Type::Texture, texture.name);
 
-        ALLEGRO_BITMAP* bitmap = al_load_bitmap(fileName.c_str());
+        const void* data = nullptr;
+        PiUInt64 size = 0;
+        GetResourcePaths().GetData(ResourcePaths::Type::Texture, texture.name, data, size);
+
+        ALLEGRO_BITMAP* bitmap = _diskCache.Load(fileName, data, size);
 
-        if (bitmap != nullptr)
+        if (bitmap == nullptr)
+        {
+            Log::Write(Log::Level::Error, "Texture file not found: %s", fileName.c_str());
+
+            // Remembered like failed asynchronous loads, so drawing the texture doesn't load it again.
+            _failedTextures[texture] = IResourceLoader::LoadStatus::ErrorFileNotFound;
+            return IResourceLoader::LoadStatus::ErrorFileNotFound;
+        }
+
+        AddTexture(texture, bitmap);
+        return IResourceLoader::LoadStatus::Loaded;
+    }
+
+    IResourceLoader::LoadStatus Renderer_Allegro::LoadTextureAsync(const Texture& texture)
+    {
+        if (_textures.Contains(texture))
+            return IResourceLoader::LoadStatus::Loaded;
+
+        if (_pendingTextures.find(texture) != _pendingTextures.end())
+            return IResourceLoader::LoadStatus::Pending;
+
+        _failedTextures.erase(texture);
+
+        if (_decoders == nullptr)
+            _decoders = new ThreadPool(kTextureDecoderCount);
+
+        const PiUInt64 request = ++_lastRequest;
+        _pendingTextures[texture] = request;
+
+        DecodedTexture task = {
+            texture, request, GetResourcePaths().GetPath(ResourcePaths::Type::Texture, texture.name), nullptr, 0, nullptr
+        };
+        GetResourcePaths().GetData(ResourcePaths::Type::Texture, texture.name, task.data, task.size);
+
+        _decoders->Enqueue(
+            [this, task]() mutable
+            {
+                // Bitmap flags are per thread. Memory bitmaps don't need a display, they are uploaded by Begin().
+                al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+                task.bitmap = _diskCache.Load(task.fileName, task.data, task.size);
+
+                std::lock_guard<std::mutex> lock(_decodedMutex);
+                _decoded.push_back(std::move(task));
+            });
+
+        return IResourceLoader::LoadStatus::Pending;
+    }
+
+    IResourceLoader::LoadStatus Renderer_Allegro::GetTextureStatus(const Texture& texture) const
+    {
+        if (_textures.Contains(texture))
+            return IResourceLoader::LoadStatus::Loaded;
+
+        if (_pendingTextures.find(texture) != _pendingTextures.end())
+            return IResourceLoader::LoadStatus::Pending;
+
+        if (auto it = _failedTextures.find(texture); it != _failedTextures.end())
+            return it->second;
+
+        return IResourceLoader::LoadStatus::Unloaded;
+    }
+
+    void Renderer_Allegro::AddTexture(const Texture& texture, ALLEGRO_BITMAP* bitmap)
+    {
+        TrackMemoryBitmaps();
+
+        TextureData_Allegro data;
+        data.width = al_get_bitmap_width(bitmap);
+        data.height = al_get_bitmap_height(bitmap);
+        data.readable = false;
+        data.bytes = static_cast<PiUInt64>(data.width) * static_cast<PiUInt64>(data.height) * 4;
+        data.lastUsedFrame = _frame;
+
+        ALLEGRO_BITMAP* sub = nullptr;
+
+        // Small textures are copied in the atlas, so that draws using them can be batched together.
+        // Without a display on this thread, the bitmap is a memory bitmap and the atlas pages can't be drawn to.
+        if (al_get_current_display() != nullptr &&
+            _atlas.CanPack(static_cast<PiInt32>(data.width), static_cast<PiInt32>(data.height)))
+        {
+            Flush();
+            sub = _atlas.Add(bitmap, data.page, data.region);
+        }
+
+        if (sub != nullptr)
+        {
+            al_destroy_bitmap(bitmap);
+
+            data.texture = deleted_unique_ptr<ALLEGRO_BITMAP>(
+                sub,
+                [this, page = data.page](ALLEGRO_BITMAP* b)
+                {
+                    al_destroy_bitmap(b);
+                    _atlas.Release(page);
+                });
+        }
+        else
         {
-            TextureData_Allegro data;
+            // Decoded bitmaps are uploaded now, the display being current on this thread.
+            if (al_get_current_display() != nullptr && (al_get_bitmap_flags(bitmap) & ALLEGRO_MEMORY_BITMAP) != 0)
+                al_convert_bitmap(bitmap);
+
+            data.page = nullptr;
             data.texture = deleted_unique_ptr<ALLEGRO_BITMAP>(
                 bitmap,
                 [](ALLEGRO_BITMAP* b)
@@ -377,54 +1246,332 @@ namespace SparkyStudios::UI::Pixel
                     if (b)
                         al_destroy_bitmap(b);
                 });
-            data.width = al_get_bitmap_width(bitmap);
-            data.height = al_get_bitmap_height(bitmap);
-            data.readable = false;
-            _lastTexture = &(*_textures.insert({ texture, std::move(data) }).first);
+        }
 
-            return IResourceLoader::LoadStatus::Loaded;
+        TextureEntry* entry = _textures.Insert(texture, std::move(data));
+        _textureBytes += entry->second.bytes;
+
+        // Textures loaded on demand by a draw call are cached without reference.
+        if (_textureRefs.find(texture) == _textureRefs.end())
+        {
+            entry->second.unused = true;
+            entry->second.lru = _unusedTextures.insert(_unusedTextures.end(), entry->first);
         }
-        else
+
+        EvictTextures();
+    }
+
+    void Renderer_Allegro::UploadDecodedTextures()
+    {
+        std::vector<DecodedTexture> decoded;
+
         {
-            Log::Write(Log::Level::Error, "Texture file not found: %s", fileName.c_str());
-            return IResourceLoader::LoadStatus::ErrorFileNotFound;
+            std::lock_guard<std::mutex> lock(_decodedMutex);
+            decoded.swap(_decoded);
+        }
+
+        for (auto&& result : decoded)
+        {
+            const auto it = _pendingTextures.find(result.texture);
+
+            // The texture has been freed, or loaded again, since the request.
+            if (it == _pendingTextures.end() || it->second != result.request)
+            {
+                if (result.bitmap != nullptr)
+                    al_destroy_bitmap(result.bitmap);
+
+                continue;
+            }
+
+            _pendingTextures.erase(it);
+
+            if (result.bitmap == nullptr)
+            {
+                Log::Write(Log::Level::Error, "Texture file not found: %s", result.fileName.c_str());
+                _failedTextures[result.texture] = IResourceLoader::LoadStatus::ErrorFileNotFound;
+                continue;
+            }
+
+            AddTexture(result.texture, result.bitmap);
         }
     }
 
     void Renderer_Allegro::FreeTexture(const Texture& texture)
     {
-        if (_lastTexture != nullptr && _lastTexture->first == texture)
-            _lastTexture = nullptr;
+        // The pending geometry may still reference this texture.
+        Flush();
+
+        if (TextureEntry* entry = _textures.Find(texture); entry != nullptr)
+        {
+            _textureBytes -= entry->second.bytes;
+
+            if (entry->second.unused)
+                _unusedTextures.erase(entry->second.lru);
+
+            _textures.Erase(texture);
+        }
 
-        _textures.erase(texture);
+        _pendingTextures.erase(texture);
+        _failedTextures.erase(texture);
     }
 
-    TextureData Renderer_Allegro::GetTextureData(const Texture& texture) const
+    IResourceLoader::LoadStatus Renderer_Allegro::AcquireTexture(const Texture& texture, bool async)
     {
-        if (_lastTexture != nullptr && _lastTexture->first == texture)
-            return _lastTexture->second;
+        _textureRefs[texture]++;
 
-        auto it = _textures.find(texture);
-        if (it != _textures.end())
+        if (TextureEntry* entry = _textures.Find(texture); entry != nullptr)
         {
-            return it->second;
+            if (entry->second.unused)
+            {
+                _unusedTextures.erase(entry->second.lru);
+                entry->second.unused = false;
+            }
+
+            return IResourceLoader::LoadStatus::Loaded;
+        }
+
+        if (_pendingTextures.find(texture) != _pendingTextures.end())
+            return IResourceLoader::LoadStatus::Pending;
+
+        return async ? LoadTextureAsync(texture) : LoadTexture(texture);
+    }
+
+    void Renderer_Allegro::ReleaseTexture(const Texture& texture)
+    {
+        auto ref = _textureRefs.find(texture);
+
+        if (ref == _textureRefs.end())
+        {
+            Log::Write(Log::Level::Warning, "Released a texture which was not acquired: %s", texture.name.c_str());
+            return;
+        }
+
+        if (--ref->second > 0)
+            return;
+
+        _textureRefs.erase(ref);
+
+        if (TextureEntry* entry = _textures.Find(texture); entry != nullptr)
+        {
+            entry->second.unused = true;
+            entry->second.lru = _unusedTextures.insert(_unusedTextures.end(), entry->first);
+
+            EvictTextures();
+            return;
+        }
+
+        // Nobody waits for the texture anymore, the decoded result is dropped.
+        _pendingTextures.erase(texture);
+        _failedTextures.erase(texture);
+    }
+
+    void Renderer_Allegro::SetTextureBudget(PiUInt64 bytes)
+    {
+        _textureBudget = bytes;
+        EvictTextures();
+    }
+
+    PiUInt64 Renderer_Allegro::GetTextureBudget() const
+    {
+        return _textureBudget;
+    }
+
+    BaseRenderer::TextureCacheStats Renderer_Allegro::GetTextureCacheStats() const
+    {
+        TextureCacheStats stats;
+        stats.textures = static_cast<PiUInt32>(_textures.Size());
+        stats.referencedTextures = static_cast<PiUInt32>(_textures.Size() - _unusedTextures.size());
+        stats.usedBytes = _textureBytes;
+        stats.budget = _textureBudget;
+        stats.evictions = _textureEvictions;
+
+        return stats;
+    }
+
+    void Renderer_Allegro::TouchTexture(TextureData_Allegro& data)
+    {
+        data.lastUsedFrame = _frame;
+
+        if (data.unused)
+            _unusedTextures.splice(_unusedTextures.end(), _unusedTextures, data.lru);
+    }
+
+    void Renderer_Allegro::EvictTextures()
+    {
+        while (_textureBytes > _textureBudget && !_unusedTextures.empty())
+        {
+            const Texture texture = _unusedTextures.front();
+
+            // The list is ordered by use, every remaining texture is drawn in the current frame.
+            if (_textures.Find(texture)->second.lastUsedFrame == _frame)
+                break;
+
+            FreeTexture(texture);
+            _textureEvictions++;
+        }
+    }
+
+    std::vector<BaseRenderer::PreloadTiming> Renderer_Allegro::Preload(const std::vector<Font>& fonts, const std::vector<Texture>& textures)
+    {
+        struct Job
+        {
+            PreloadTiming timing;
+            Font font;
+            Texture texture;
+            PiString fileName;
+            const void* data = nullptr;
+            PiUInt64 size = 0;
+
+            // The decoded resource, a memory bitmap for textures.
+            BakedFont_Allegro* baked = nullptr;
+            ALLEGRO_BITMAP* bitmap = nullptr;
+        };
+
+        std::vector<Job> jobs;
+        jobs.reserve(fonts.size() + textures.size());
+
+        for (auto&& font : fonts)
+        {
+            if (FindFont(font) != nullptr)
+                continue;
+
+            Job& job = jobs.emplace_back();
+            job.timing.type = ResourcePaths::Type::Font;
+            job.timing.name = font.facename + " " + std::to_string(static_cast<PiUInt32>(font.size));
+            job.font = font;
+        }
+
+        for (auto&& texture : textures)
+        {
+            if (_textures.Contains(texture) || _pendingTextures.find(texture) != _pendingTextures.end())
+                continue;
+
+            Job& job = jobs.emplace_back();
+            job.timing.type = ResourcePaths::Type::Texture;
+            job.timing.name = texture.name;
+            job.texture = texture;
+            job.fileName = GetResourcePaths().GetPath(ResourcePaths::Type::Texture, texture.name);
+            GetResourcePaths().GetData(ResourcePaths::Type::Texture, texture.name, job.data, job.size);
         }
 
+        if (jobs.empty())
+            return {};
+
+        // Decode every resource in parallel into memory bitmaps. TrueType fonts are loaded on this
+        // thread afterwards, FreeType can't load fonts from several threads.
+        {
+            const PiUInt32 threadCount = std::min<PiUInt32>(std::max(std::thread::hardware_concurrency(), 1u), jobs.size());
+            ThreadPool workers(threadCount);
+
+            for (auto&& job : jobs)
+            {
+                workers.Enqueue(
+                    [this, &job]()
+                    {
+                        al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+                        const PiTime start = Platform::GetTimeInSeconds();
+
+                        if (job.timing.type == ResourcePaths::Type::Font)
+                            job.baked = LoadBakedFont(job.font);
+                        else
+                            job.bitmap = _diskCache.Load(job.fileName, job.data, job.size);
+
+                        job.timing.decodeTime = Platform::GetTimeInSeconds() - start;
+                    });
+            }
+        }
+
+        // Upload the decoded resources in a single pass.
+        std::vector<PreloadTiming> timings;
+        timings.reserve(jobs.size());
+
+        for (auto&& job : jobs)
+        {
+            const PiTime start = Platform::GetTimeInSeconds();
+
+            if (job.timing.type == ResourcePaths::Type::Font)
+            {
+                job.timing.status = AddFont(job.font, job.baked);
+
+                // Rasterize the common glyphs now, instead of when they are first drawn.
+                if (job.timing.status == LoadStatus::Loaded && job.baked == nullptr && IsBatchingEnabled())
+                {
+                    Flush();
+                    _glyphs.BuildRun(FindFont(job.font)->second.font.get(), kPreloadGlyphs);
+                }
+            }
+            else if (job.bitmap != nullptr)
+            {
+                AddTexture(job.texture, job.bitmap);
+                job.timing.status = LoadStatus::Loaded;
+            }
+            else
+            {
+                Log::Write(Log::Level::Error, "Texture file not found: %s", job.fileName.c_str());
+                job.timing.status = LoadStatus::ErrorFileNotFound;
+            }
+
+            job.timing.uploadTime = Platform::GetTimeInSeconds() - start;
+            timings.push_back(job.timing);
+        }
+
+        return timings;
+    }
+
+    void Renderer_Allegro::SetTextureDiskCacheDirectory(const PiString& directory)
+    {
+        // Wait for the running decodes, which read the cache directory.
+        if (_decoders != nullptr)
+            _decoders->Wait();
+
+        _diskCache.SetDirectory(directory);
+    }
+
+    PiString Renderer_Allegro::GetTextureDiskCacheDirectory() const
+    {
+        return _diskCache.GetDirectory();
+    }
+
+    TextureData Renderer_Allegro::GetTextureData(const Texture& texture) const
+    {
+        if (const TextureEntry* entry = _textures.Find(texture); entry != nullptr)
+            return entry->second;
+
         return TextureData();
     }
 
+    BaseRenderer::TextureAtlasStats Renderer_Allegro::GetTextureAtlasStats() const
+    {
+        return _atlas.GetStats();
+    }
+
+    BaseRenderer::ShapeCacheStats Renderer_Allegro::GetShapeCacheStats() const
+    {
+        return _shapes.GetStats();
+    }
+
     bool Renderer_Allegro::EnsureTexture(const Texture& texture)
     {
-        if (_lastTexture != nullptr && _lastTexture->first == texture)
-            return true;
+        return ResolveTexture(texture) != nullptr;
+    }
+
+    Renderer_Allegro::TextureEntry* Renderer_Allegro::ResolveTexture(const Texture& texture)
+    {
+        TextureEntry* entry = _textures.Find(texture);
 
-        auto it = _textures.find(texture);
-        if (it != _textures.end())
+        if (entry == nullptr)
         {
-            _lastTexture = &(*it);
-            return true;
+            // Textures loading asynchronously are drawn as missing until they are uploaded.
+            if (_pendingTextures.find(texture) != _pendingTextures.end() || _failedTextures.find(texture) != _failedTextures.end())
+                return nullptr;
+
+            if (LoadTexture(texture) != IResourceLoader::LoadStatus::Loaded)
+                return nullptr;
+
+            entry = _textures.Find(texture);
         }
 
-        return LoadTexture(texture) == IResourceLoader::LoadStatus::Loaded;
+        TouchTexture(entry->second);
+        return entry;
     }
 } // namespace SparkyStudios::UI::Pixel
\ No newline at end of file
@@ -19,13 +19,26 @@
 
 #include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
 
+#include <Core/Allegro5/Renderer/BakedFont.h>
+#include <Core/Allegro5/Renderer/DrawBatch.h>
+#include <Core/Allegro5/Renderer/GlyphAtlas.h>
+#include <Core/Allegro5/Renderer/ShapeCache.h>
+#include <Core/Allegro5/Renderer/TextureAtlas.h>
+#include <Core/Allegro5/Renderer/TextureDiskCache.h>
+#include <Core/Renderer/ResourceTable.h>
+#include <Core/ThreadPool.h>
+
 #include <allegro5/allegro_font.h>
+#include <allegro5/allegro_memfile.h>
 #include <allegro5/allegro_primitives.h>
 #include <allegro5/allegro_ttf.h>
 
+#include <atomic>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -35,14 +48,32 @@ namespace SparkyStudios::UI::Pixel
     {
         struct CacheEntry
         {
-            ALLEGRO_BITMAP* m_bitmap;
+            ALLEGRO_BITMAP* m_bitmap = nullptr;
+
+            // The size of the widget, the bitmap may be larger.
+            Size m_size;
+            PiReal32 m_scale = 1.0f;
+
+            // Whether the bitmap holds the rendered widget.
+            bool m_valid = false;
+
+            PiUInt64 m_lastUsedFrame = 0;
+            std::list<CacheHandle>::iterator m_lru;
         };
 
         typedef std::map<CacheHandle, CacheEntry> CacheMap;
 
+        // Unused bitmaps, keyed by their bucketed pixel size.
+        typedef std::multimap<std::pair<PiInt32, PiInt32>, ALLEGRO_BITMAP*> BitmapPool;
+
     public:
+        /**
+         * @brief The default memory budget of the cache textures, in bytes.
+         */
+        static constexpr PiUInt64 kDefaultBudget = 64ull * 1024 * 1024;
+
         CacheToTexture_Allegro();
-        ~CacheToTexture_Allegro() override = default;
+        ~CacheToTexture_Allegro() override;
 
         void Initialize() override;
         void ShutDown() override;
@@ -53,15 +84,57 @@ namespace SparkyStudios::UI::Pixel
         void SetRenderer(BaseRenderer* renderer) override;
 
         void DrawCachedWidgetTexture(CacheHandle control) override;
-        void CreateWidgetCacheTexture(CacheHandle control, const Size& size) override;
+        bool CreateWidgetCacheTexture(CacheHandle control, const Size& size) override;
+        void FreeWidgetCacheTexture(CacheHandle control) override;
+        bool IsWidgetCacheTextureValid(CacheHandle control) const override;
         void UpdateWidgetCacheTexture(CacheHandle control) override;
 
-        // TODO: Why destroys the cached textures? Does this assume they always exist?
+        void SetBudget(PiUInt64 bytes) override;
+        PiUInt64 GetBudget() const override;
+        Stats GetStats() const override;
+
+        /**
+         * @brief Starts a new frame. Textures used during the current frame are never evicted.
+         */
+        void NewFrame();
 
     private:
+        /**
+         * @brief Gets the pixel size of the bitmap used to cache a widget of the given size.
+         */
+        std::pair<PiInt32, PiInt32> GetBucket(const Size& size) const;
+
+        /**
+         * @brief Gets a bitmap of the given pixel size from the pool, or creates it.
+         */
+        ALLEGRO_BITMAP* AcquireBitmap(const std::pair<PiInt32, PiInt32>& bucket);
+
+        /**
+         * @brief Keeps an unused bitmap in the pool, or destroys it when the cache is over budget.
+         */
+        void ReleaseBitmap(ALLEGRO_BITMAP* bitmap);
+
+        /**
+         * @brief Frees pooled bitmaps, then idle widget textures, until the given amount of memory is available.
+         *
+         * @return Whether enough memory could be freed.
+         */
+        bool MakeRoom(PiUInt64 bytes);
+
+        void DestroyBitmap(ALLEGRO_BITMAP* bitmap);
+
         BaseRenderer* _renderer;
         CacheMap _cache;
+        BitmapPool _pool;
+        std::list<CacheHandle> _lru;
         ALLEGRO_BITMAP* _oldTarget;
+
+        PiUInt64 _budget;
+        PiUInt64 _usedBytes;
+        PiUInt64 _frame;
+        PiUInt64 _allocations;
+        PiUInt64 _reuses;
+        PiUInt64 _evictions;
     };
 
     class Renderer_Allegro : public BaseRenderer
@@ -81,6 +154,12 @@ namespace SparkyStudios::UI::Pixel
                 std::swap(width, other.width);
                 std::swap(height, other.height);
                 std::swap(readable, other.readable);
+                std::swap(page, other.page);
+                std::swap(region, other.region);
+                std::swap(bytes, other.bytes);
+                std::swap(lastUsedFrame, other.lastUsedFrame);
+                std::swap(unused, other.unused);
+                std::swap(lru, other.lru);
                 texture.swap(other.texture);
             }
 
@@ -88,6 +167,17 @@ namespace SparkyStudios::UI::Pixel
             {}
 
             deleted_unique_ptr<ALLEGRO_BITMAP> texture;
+
+            // The atlas page holding the texture, if it has been packed.
+            ALLEGRO_BITMAP* page = nullptr;
+            Rect region;
+
+            PiUInt64 bytes = 0;
+            PiUInt64 lastUsedFrame = 0;
+
+            // Whether the texture holds no reference, and can be evicted.
+            bool unused = false;
+            std::list<Texture>::iterator lru;
         };
 
         struct FontData_Allegro
@@ -100,18 +190,97 @@ namespace SparkyStudios::UI::Pixel
                 : FontData_Allegro()
             {
                 font.swap(other.font);
+                baked.swap(other.baked);
+                std::swap(lastUsedTime, other.lastUsedTime);
             }
 
             ~FontData_Allegro()
             {}
 
+            /**
+             * @brief Gets the handle of the font in the text measure cache.
+             */
+            TextMeasureCache::FontHandle GetHandle() const
+            {
+                return baked != nullptr ? reinterpret_cast<TextMeasureCache::FontHandle>(baked.get())
+                                        : reinterpret_cast<TextMeasureCache::FontHandle>(font.get());
+            }
+
             deleted_unique_ptr<ALLEGRO_FONT> font;
+
+            // The baked font loaded instead of the TrueType font, if any.
+            std::unique_ptr<BakedFont_Allegro> baked;
+
+            PiTime lastUsedTime = 0;
+        };
+
+        // A font at the pixel size it is rasterized at. Fonts are loaded once for each UI scale they are drawn at.
+        struct ScaledFont
+        {
+            ScaledFont(const Font& font, PiUInt32 pixelSize)
+                : font(font)
+                , pixelSize(pixelSize)
+                , handle(0)
+            {}
+
+            bool operator==(const ScaledFont& rhs) const
+            {
+                return pixelSize == rhs.pixelSize && font == rhs.font;
+            }
+
+            struct Hash
+            {
+                std::size_t operator()(const ScaledFont& f) const noexcept
+                {
+                    std::size_t res = std::hash<Font>{}(f.font);
+                    HashCombine<decltype(f.pixelSize)>(res, f.pixelSize);
+
+                    return res;
+                }
+            };
+
+            Font font;
+            PiUInt32 pixelSize;
+            mutable PiHandle handle;
         };
 
+        struct DecodedTexture
+        {
+            Texture texture;
+            PiUInt64 request;
+            PiString fileName;
+
+            // The content of the file, when it is already in memory.
+            const void* data;
+            PiUInt64 size;
+
+            // The decoded memory bitmap, or nullptr if the file couldn't be loaded.
+            ALLEGRO_BITMAP* bitmap;
+        };
+
+        typedef ResourceTable<ScaledFont, FontData_Allegro, ScaledFont::Hash>::Entry FontEntry;
+        typedef ResourceTable<Texture, TextureData_Allegro>::Entry TextureEntry;
+
     public:
+        /**
+         * @brief The default memory budget of the loaded textures, in bytes.
+         */
+        static constexpr PiUInt64 kDefaultTextureBudget = 128ull * 1024 * 1024;
+
+        /**
+         * @brief The time in seconds a font loaded for a previous scale stays loaded without being drawn.
+         *
+         * Fonts are kept a while after a scale change, so moving back and forth between displays
+         * of different densities doesn't reload them. The delay is measured in time rather than in
+         * frames, since frames are only painted on demand in the OnDemand render mode.
+         */
+        static constexpr PiTime kFontRetireDelay = 5.0;
+
         Renderer_Allegro(ResourcePaths& paths);
         virtual ~Renderer_Allegro();
 
+        void Flush() override;
+
         void SetDrawColor(const Color& color) override;
 
         void StartClip() override;
@@ -141,6 +310,8 @@ namespace SparkyStudios::UI::Pixel
 
         Size MeasureText(const Font& font, const PiString& text) override;
 
+        void Begin() override;
+
         bool InitializeContext(MainWindow* window) override;
 
         bool DestroyContext(MainWindow* window);
@@ -149,10 +320,23 @@ namespace SparkyStudios::UI::Pixel
 
         bool BeginContext(MainWindow* window) override;
 
+        bool BeginContext(MainWindow* window, const Rect& region) override;
+
         bool EndContext(MainWindow* window) override;
 
         bool PresentContext(MainWindow* window) override;
 
+        bool PresentContext(MainWindow* window, const Rect& region) override;
+
+        bool CanPresentRegion(MainWindow* window) override;
+
+        /**
+         * @brief Converts the memory bitmaps to video bitmaps when the next frame begins, eg. after the display has been reset.
+         *
+         * Bitmaps created by this renderer on a thread without a display are converted that way too.
+         */
+        void ConvertMemoryBitmapsLater();
+
         ICacheToTexture* GetCTT() override;
 
         IResourceLoader::LoadStatus LoadFont(const Font& font);
@@ -163,20 +347,189 @@ namespace SparkyStudios::UI::Pixel
 
         IResourceLoader::LoadStatus LoadTexture(const Texture& texture) override;
 
+        IResourceLoader::LoadStatus LoadTextureAsync(const Texture& texture) override;
+
+        IResourceLoader::LoadStatus GetTextureStatus(const Texture& texture) const override;
+
         void FreeTexture(const Texture& texture) override;
 
+        IResourceLoader::LoadStatus AcquireTexture(const Texture& texture, bool async = false) override;
+
+        void ReleaseTexture(const Texture& texture) override;
+
         TextureData GetTextureData(const Texture& texture) const override;
 
+        TextureAtlasStats GetTextureAtlasStats() const override;
+
+        ShapeCacheStats GetShapeCacheStats() const override;
+
+        void SetTextureBudget(PiUInt64 bytes) override;
+
+        PiUInt64 GetTextureBudget() const override;
+
+        TextureCacheStats GetTextureCacheStats() const override;
+
+        std::vector<PreloadTiming> Preload(const std::vector<Font>& fonts, const std::vector<Texture>& textures) override;
+
+        void SetTextureDiskCacheDirectory(const PiString& directory) override;
+
+        PiString GetTextureDiskCacheDirectory() const override;
+
         bool EnsureTexture(const Texture& texture) override;
 
     private:
-        std::unordered_map<Font, FontData_Allegro> _fonts;
-        std::unordered_map<Texture, TextureData_Allegro> _textures;
-        std::pair<const Font, FontData_Allegro>* _lastFont;
-        std::pair<const Texture, TextureData_Allegro>* _lastTexture;
+        /**
+         * @brief Makes room in the batch for the given geometry.
+         *
+         * @param texture The texture used by the geometry.
+         * @param vertexCount The number of vertices of the geometry.
+         */
+        void PrepareBatch(ALLEGRO_BITMAP* texture, std::size_t vertexCount);
+
+        /**
+         * @brief Flushes the batch before an immediate draw call.
+         */
+        void PrepareImmediate();
+
+        /**
+         * @brief Sets the UI scale transformation on the target bitmap, unless it is already set.
+         */
+        void ApplyTransform();
+
+        /**
+         * @brief Sets the clipping rectangle of the target bitmap, unless it is already set.
+         *
+         * @param rect The clipping rectangle, in pixels.
+         */
+        void ApplyClip(const Rect& rect);
+
+        /**
+         * @brief Takes ownership of a loaded bitmap as the given texture.
+         *
+         * Small textures are copied in the atlas, other memory bitmaps are uploaded if a display is available.
+         */
+        void AddTexture(const Texture& texture, ALLEGRO_BITMAP* bitmap);
+
+        /**
+         * @brief Uploads the textures decoded by the worker threads since the last call.
+         */
+        void UploadDecodedTextures();
+
+        /**
+         * @brief Loads the baked version of a font at the current scale, if it exists.
+         *
+         * @return The baked font, or nullptr if there is no baked font file for this font and size.
+         */
+        BakedFont_Allegro* LoadBakedFont(const Font& font);
+
+        /**
+         * @brief Adds a loaded font, the baked font if any, or the TrueType font.
+         *
+         * @param font The font.
+         * @param baked The baked font, owned by the renderer from now on, or nullptr to load the TrueType font.
+         */
+        IResourceLoader::LoadStatus AddFont(const Font& font, BakedFont_Allegro* baked);
+
+        /**
+         * @brief Gets the pixel size a font is rasterized at, with the current scale.
+         */
+        PiUInt32 GetFontPixelSize(const Font& font) const;
+
+        /**
+         * @brief Finds a font loaded at the current scale.
+         *
+         * @return The font, or nullptr if it isn't loaded at this scale.
+         */
+        FontEntry* FindFont(const Font& font);
+
+        /**
+         * @brief Finds a font loaded at the current scale, or loads it, and marks it as used in the current frame.
+         *
+         * @return The font, or nullptr if it couldn't be loaded.
+         */
+        FontEntry* ResolveFont(const Font& font);
+
+        /**
+         * @brief Frees a font loaded at the given pixel size.
+         */
+        void FreeScaledFont(const ScaledFont& font);
+
+        /**
+         * @brief Frees the fonts loaded for a previous scale once they haven't been drawn for a while.
+         */
+        void RetireFonts();
+
+        /**
+         * @brief Finds a texture, or loads it, and marks it as used in the current frame.
+         *
+         * @return The texture, or nullptr if it couldn't be loaded or is still loading asynchronously.
+         */
+        TextureEntry* ResolveTexture(const Texture& texture);
+
+        /**
+         * @brief Marks a texture as used in the current frame.
+         */
+        void TouchTexture(TextureData_Allegro& data);
+
+        /**
+         * @brief Frees the least recently used unreferenced textures until the texture budget is respected.
+         */
+        void EvictTextures();
+
+        /**
+         * @brief Remembers to convert the memory bitmaps when bitmaps may be created without a display on this thread.
+         */
+        void TrackMemoryBitmaps();
+
+        /**
+         * @brief Converts the memory bitmaps if any has been created without a display since the last frame.
+         */
+        void ConvertMemoryBitmaps();
+
+        // Declared first, the atlas must outlive the textures packed in it.
+        TextureAtlas_Allegro _atlas;
+
+        // Looked up through the handles interned in the Font and Texture values.
+        ResourceTable<ScaledFont, FontData_Allegro, ScaledFont::Hash> _fonts;
+        ResourceTable<Texture, TextureData_Allegro> _textures;
+
+        // Texture references, and unreferenced textures from the least to the most recently used.
+        std::unordered_map<Texture, PiUInt32> _textureRefs;
+        std::list<Texture> _unusedTextures;
+        PiUInt64 _textureBytes;
+        PiUInt64 _textureBudget;
+        PiUInt64 _textureEvictions;
+        PiUInt64 _frame;
+        PiTime _frameTime;
+
+        // The scale the fonts have been loaded at, and whether fonts loaded at other scales remain.
+        PiReal32 _fontScale;
+        bool _retiringFonts;
 
         ALLEGRO_COLOR _color;
+        Color _drawColor;
+        bool _hasDrawColor;
+        ALLEGRO_BITMAP* _clipTarget;
+        Rect _clipRect;
+        ALLEGRO_BITMAP* _transformTarget;
+        PiReal32 _transformScale;
+        Rect _frameRegion;
         CacheToTexture_Allegro* _ctt;
+        DrawBatch_Allegro _batch;
+        ShapeCache_Allegro _shapes;
+        GlyphAtlas_Allegro _glyphs;
+        TextureDiskCache_Allegro _diskCache;
+
+        // Asynchronous texture loading, the pool is started by the first request.
+        ThreadPool* _decoders;
+        std::mutex _decodedMutex;
+        std::vector<DecodedTexture> _decoded;
+        std::unordered_map<Texture, PiUInt64> _pendingTextures;
+        std::unordered_map<Texture, IResourceLoader::LoadStatus> _failedTextures;
+        PiUInt64 _lastRequest;
+
+        // Whether memory bitmaps wait to be converted by the thread owning the display.
+        std::atomic<bool> _memoryBitmaps;
     };
 } // namespace SparkyStudios::UI::Pixel
 
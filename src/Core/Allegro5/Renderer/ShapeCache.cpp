@@ -0,0 +1,215 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Common.h>
+
+#include <Core/Allegro5/Renderer/ShapeCache.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SparkyStudios::UI::Pixel
+{
+    // The same quality factor as Allegro primitives, so cached shapes look the same.
+    static constexpr PiReal32 kTessellationQuality = 10.0f;
+
+    static constexpr PiReal32 kHalfPi = 1.57079632679489661923f;
+
+    std::size_t ShapeCache_Allegro::KeyHasher::operator()(const Key& key) const
+    {
+        std::size_t hash = std::hash<PiUInt8>{}(static_cast<PiUInt8>(key.shape));
+        HashCombine(hash, key.w);
+        HashCombine(hash, key.h);
+        HashCombine(hash, key.rx);
+        HashCombine(hash, key.ry);
+        HashCombine(hash, key.thickness);
+        HashCombine(hash, key.scale);
+        return hash;
+    }
+
+    ShapeCache_Allegro::ShapeCache_Allegro(std::size_t capacity)
+        : _capacity(std::max<std::size_t>(capacity, 1))
+    {}
+
+    const ShapeCache_Allegro::Geometry& ShapeCache_Allegro::Get(
+        Shape shape, PiReal32 w, PiReal32 h, PiReal32 rx, PiReal32 ry, PiReal32 thickness, PiReal32 scale)
+    {
+        const bool ellipse = shape == Shape::FilledEllipse || shape == Shape::LinedEllipse;
+        const bool filled = shape == Shape::FilledRoundedRect || shape == Shape::FilledEllipse;
+
+        // Normalize the parameters ignored by the shape, so they don't split the cache.
+        const Key key = { shape, w, h, ellipse ? 0.0f : rx, ellipse ? 0.0f : ry, filled ? 0.0f : thickness, scale };
+
+        if (const auto it = _index.find(key); it != _index.end())
+        {
+            // Move the entry to the front, as the most recently used one.
+            _entries.splice(_entries.begin(), _entries, it->second);
+
+            _stats.hits++;
+            return it->second->geometry;
+        }
+
+        _stats.misses++;
+
+        _entries.push_front({ key, Geometry() });
+        _index.emplace(key, _entries.begin());
+
+        Geometry& geometry = _entries.front().geometry;
+        Path path;
+
+        if (ellipse)
+        {
+            TessellatePath(0.0f, 0.0f, w, h, w * 0.5f, h * 0.5f, scale, path);
+
+            if (filled)
+                Fill(path, w * 0.5f, h * 0.5f, { w * 0.5f, h * 0.5f }, geometry);
+            else
+                Stroke(path, w * 0.5f, h * 0.5f, thickness, geometry);
+        }
+        else if (filled)
+        {
+            rx = std::min(rx, w * 0.5f);
+            ry = std::min(ry, h * 0.5f);
+
+            TessellatePath(0.0f, 0.0f, w, h, rx, ry, scale, path);
+            Fill(path, rx, ry, { w * 0.5f, h * 0.5f }, geometry);
+        }
+        else
+        {
+            // The outline is drawn inside the bounds, centered on the rectangle inset by half the thickness.
+            const PiReal32 offset = thickness * 0.5f;
+
+            rx = std::min(rx, (w - thickness) * 0.5f);
+            ry = std::min(ry, (h - thickness) * 0.5f);
+
+            TessellatePath(offset, offset, w - thickness, h - thickness, rx, ry, scale, path);
+            Stroke(path, rx, ry, thickness, geometry);
+        }
+
+        while (_entries.size() > _capacity)
+        {
+            _index.erase(_entries.back().key);
+            _entries.pop_back();
+            _stats.evictions++;
+        }
+
+        return geometry;
+    }
+
+    void ShapeCache_Allegro::Clear()
+    {
+        _index.clear();
+        _entries.clear();
+    }
+
+    BaseRenderer::ShapeCacheStats ShapeCache_Allegro::GetStats() const
+    {
+        BaseRenderer::ShapeCacheStats stats = _stats;
+        stats.shapes = static_cast<PiUInt32>(_entries.size());
+
+        return stats;
+    }
+
+    void ShapeCache_Allegro::TessellatePath(
+        PiReal32 x, PiReal32 y, PiReal32 w, PiReal32 h, PiReal32 rx, PiReal32 ry, PiReal32 scale, Path& path)
+    {
+        rx = std::max(rx, 0.0f);
+        ry = std::max(ry, 0.0f);
+
+        // Allegro picks the number of segments of a whole ellipse the same way.
+        const PiReal32 segments = kTessellationQuality * std::sqrt(scale * (rx + ry) * 0.5f);
+        const PiUInt32 quarter = std::clamp(static_cast<PiUInt32>(std::ceil(segments * 0.25f)), 2u, 64u);
+
+        // Corners in clockwise order, starting from the top right one, which starts at the top.
+        const Vertex corners[4] = {
+            { x + w - rx, y + ry },
+            { x + w - rx, y + h - ry },
+            { x + rx, y + h - ry },
+            { x + rx, y + ry },
+        };
+
+        path.centers.clear();
+        path.directions.clear();
+        path.centers.reserve(4 * (quarter + 1));
+        path.directions.reserve(4 * (quarter + 1));
+
+        for (PiUInt32 corner = 0; corner < 4; corner++)
+        {
+            for (PiUInt32 i = 0; i <= quarter; i++)
+            {
+                const PiReal32 angle = kHalfPi * (static_cast<PiReal32>(corner) - 1.0f + static_cast<PiReal32>(i) / quarter);
+                const Vertex center = corners[corner];
+                const Vertex direction = { std::cos(angle), std::sin(angle) };
+
+                // Corners sharing their center, as in an ellipse, would repeat their common point.
+                if (i == 0 && !path.centers.empty() && path.centers.back().x == center.x && path.centers.back().y == center.y)
+                    continue;
+
+                path.centers.push_back(center);
+                path.directions.push_back(direction);
+            }
+        }
+
+        if (path.centers.size() > 1 && path.centers.front().x == path.centers.back().x &&
+            path.centers.front().y == path.centers.back().y)
+        {
+            path.centers.pop_back();
+            path.directions.pop_back();
+        }
+    }
+
+    void ShapeCache_Allegro::Fill(const Path& path, PiReal32 rx, PiReal32 ry, const Vertex& center, Geometry& geometry)
+    {
+        const int count = static_cast<int>(path.centers.size());
+
+        geometry.vertices.reserve(count + 1);
+        geometry.indices.reserve(count * 3);
+
+        geometry.vertices.push_back(center);
+
+        for (int i = 0; i < count; i++)
+        {
+            const Vertex& c = path.centers[i];
+            const Vertex& d = path.directions[i];
+
+            geometry.vertices.push_back({ c.x + d.x * rx, c.y + d.y * ry });
+            geometry.indices.insert(geometry.indices.end(), { 0, 1 + i, 1 + (i + 1) % count });
+        }
+    }
+
+    void ShapeCache_Allegro::Stroke(const Path& path, PiReal32 rx, PiReal32 ry, PiReal32 thickness, Geometry& geometry)
+    {
+        const int count = static_cast<int>(path.centers.size());
+        const PiReal32 offset = thickness * 0.5f;
+
+        // Like Allegro, the inner radius goes negative when the thickness exceeds the diameter, which keeps the band closed.
+        const PiReal32 inX = rx - offset, inY = ry - offset;
+        const PiReal32 outX = rx + offset, outY = ry + offset;
+
+        geometry.vertices.reserve(count * 2);
+        geometry.indices.reserve(count * 6);
+
+        for (int i = 0; i < count; i++)
+        {
+            const Vertex& c = path.centers[i];
+            const Vertex& d = path.directions[i];
+
+            geometry.vertices.push_back({ c.x + d.x * outX, c.y + d.y * outY });
+            geometry.vertices.push_back({ c.x + d.x * inX, c.y + d.y * inY });
+
+            const int outer = i * 2, next = ((i + 1) % count) * 2;
+            geometry.indices.insert(geometry.indices.end(), { outer, next, next + 1, outer, next + 1, outer + 1 });
+        }
+    }
+} // namespace SparkyStudios::UI::Pixel
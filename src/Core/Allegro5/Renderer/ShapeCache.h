@@ -0,0 +1,156 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_SHAPE_CACHE_H
+#define PIXEL_UI_SHAPE_CACHE_H
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Bounded cache of tessellated curved shapes, with least recently used eviction.
+     *
+     * Shapes are tessellated once relative to the top left corner of their bounds,
+     * then offset and colored each time they are drawn. The number of segments
+     * depends on the UI scale, so shapes are cached per scale as well.
+     */
+    class ShapeCache_Allegro
+    {
+    public:
+        /**
+         * @brief The kind of tessellated shape.
+         */
+        enum class Shape : PiUInt8
+        {
+            FilledRoundedRect,
+            LinedRoundedRect,
+            FilledEllipse,
+            LinedEllipse,
+        };
+
+        /**
+         * @brief A vertex of a tessellated shape, relative to the top left corner of its bounds.
+         */
+        struct Vertex
+        {
+            PiReal32 x;
+            PiReal32 y;
+        };
+
+        /**
+         * @brief The triangles of a tessellated shape.
+         */
+        struct Geometry
+        {
+            std::vector<Vertex> vertices;
+            std::vector<int> indices;
+        };
+
+        /**
+         * @brief Creates a new shape cache.
+         *
+         * @param capacity The maximum number of shapes to keep.
+         */
+        explicit ShapeCache_Allegro(std::size_t capacity = 512);
+
+        /**
+         * @brief Gets a tessellated shape, tessellating it if it's not cached.
+         *
+         * The geometry remains valid until the next call to this method.
+         *
+         * @param shape The kind of shape.
+         * @param w The width of the shape bounds.
+         * @param h The height of the shape bounds.
+         * @param rx The horizontal radius of the corners. Ignored for ellipses.
+         * @param ry The vertical radius of the corners. Ignored for ellipses.
+         * @param thickness The thickness of the outline. Ignored for filled shapes.
+         * @param scale The UI scale at which the shape is drawn.
+         */
+        const Geometry& Get(Shape shape, PiReal32 w, PiReal32 h, PiReal32 rx, PiReal32 ry, PiReal32 thickness, PiReal32 scale);
+
+        /**
+         * @brief Removes every shape from the cache.
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the usage statistics of the cache.
+         */
+        [[nodiscard]] BaseRenderer::ShapeCacheStats GetStats() const;
+
+    private:
+        struct Key
+        {
+            Shape shape;
+            PiReal32 w, h, rx, ry, thickness, scale;
+
+            bool operator==(const Key& other) const
+            {
+                return shape == other.shape && w == other.w && h == other.h && rx == other.rx && ry == other.ry &&
+                    thickness == other.thickness && scale == other.scale;
+            }
+        };
+
+        struct KeyHasher
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            Key key;
+            Geometry geometry;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        /**
+         * @brief The points of a path, each given by the center of its curve and its direction from that center.
+         */
+        struct Path
+        {
+            std::vector<Vertex> centers;
+            std::vector<Vertex> directions;
+        };
+
+        /**
+         * @brief Tessellates the path of a rounded rectangle. An ellipse is a rectangle rounded up to its center.
+         */
+        static void TessellatePath(PiReal32 x, PiReal32 y, PiReal32 w, PiReal32 h, PiReal32 rx, PiReal32 ry, PiReal32 scale, Path& path);
+
+        /**
+         * @brief Fills a path with a triangle fan around the given center.
+         */
+        static void Fill(const Path& path, PiReal32 rx, PiReal32 ry, const Vertex& center, Geometry& geometry);
+
+        /**
+         * @brief Strokes a path with a band of the given thickness, centered on the path.
+         */
+        static void Stroke(const Path& path, PiReal32 rx, PiReal32 ry, PiReal32 thickness, Geometry& geometry);
+
+        std::size_t _capacity;
+        EntryList _entries;
+        std::unordered_map<Key, EntryList::iterator, KeyHasher> _index;
+        BaseRenderer::ShapeCacheStats _stats;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_SHAPE_CACHE_H
@@ -0,0 +1,128 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/Allegro5/Renderer/TextureAtlas.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    static constexpr PiInt32 kPageSize = 1024;
+    static constexpr PiInt32 kMaxTextureSize = 256;
+    static constexpr PiInt32 kTexturePadding = 1;
+
+    TextureAtlas_Allegro::TextureAtlas_Allegro() = default;
+
+    TextureAtlas_Allegro::~TextureAtlas_Allegro()
+    {
+        for (auto&& page : _pages)
+            al_destroy_bitmap(page.bitmap);
+    }
+
+    bool TextureAtlas_Allegro::CanPack(PiInt32 width, PiInt32 height) const
+    {
+        return width > 0 && height > 0 && width <= kMaxTextureSize && height <= kMaxTextureSize;
+    }
+
+    ALLEGRO_BITMAP* TextureAtlas_Allegro::Add(ALLEGRO_BITMAP* bitmap, ALLEGRO_BITMAP*& page, Rect& region)
+    {
+        const PiInt32 width = al_get_bitmap_width(bitmap);
+        const PiInt32 height = al_get_bitmap_height(bitmap);
+
+        if (!CanPack(width, height))
+            return nullptr;
+
+        Page* target = nullptr;
+
+        for (auto&& candidate : _pages)
+        {
+            if (candidate.packer.Pack(width, height, region))
+            {
+                target = &candidate;
+                break;
+            }
+        }
+
+        if (target == nullptr)
+        {
+            const int flags = al_get_new_bitmap_flags();
+            al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
+            ALLEGRO_BITMAP* bitmapPage = al_create_bitmap(kPageSize, kPageSize);
+            al_set_new_bitmap_flags(flags);
+
+            if (bitmapPage == nullptr)
+                return nullptr;
+
+            _pages.push_back({ bitmapPage, AtlasPacker(kPageSize, kPageSize, kTexturePadding), 0 });
+            target = &_pages.back();
+
+            if (!target->packer.Pack(width, height, region))
+                return nullptr;
+
+            ALLEGRO_STATE state;
+            al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+            al_set_target_bitmap(bitmapPage);
+            al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+            al_restore_state(&state);
+        }
+
+        ALLEGRO_BITMAP* sub = al_create_sub_bitmap(target->bitmap, region.x, region.y, region.w, region.h);
+        if (sub == nullptr)
+            return nullptr;
+
+        // Copy the pixels as they are, alpha included.
+        ALLEGRO_STATE state;
+        al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+        al_set_target_bitmap(target->bitmap);
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+        al_draw_bitmap(bitmap, region.x, region.y, 0);
+        al_restore_state(&state);
+
+        page = target->bitmap;
+        target->textures++;
+
+        return sub;
+    }
+
+    void TextureAtlas_Allegro::Release(ALLEGRO_BITMAP* page)
+    {
+        for (auto it = _pages.begin(); it != _pages.end(); ++it)
+        {
+            if (it->bitmap != page)
+                continue;
+
+            // The space of a released texture can't be reused, so pages are only recycled once empty.
+            if (--it->textures == 0)
+            {
+                al_destroy_bitmap(it->bitmap);
+                _pages.erase(it);
+            }
+
+            return;
+        }
+    }
+
+    BaseRenderer::TextureAtlasStats TextureAtlas_Allegro::GetStats() const
+    {
+        BaseRenderer::TextureAtlasStats stats;
+
+        for (auto&& page : _pages)
+        {
+            stats.pages++;
+            stats.textures += page.textures;
+            stats.usedArea += page.packer.GetUsedArea();
+            stats.totalArea += static_cast<PiUInt64>(page.packer.GetWidth()) * page.packer.GetHeight();
+        }
+
+        return stats;
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,92 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_TEXTURE_ATLAS_H
+#define PIXEL_UI_TEXTURE_ATLAS_H
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/AtlasPacker.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
+
+#include <allegro5/allegro.h>
+
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Copies small textures into shared atlas pages, so that draws
+     * using different textures can still be batched together.
+     *
+     * Each packed texture is represented by a sub-bitmap of its page. The
+     * page is destroyed once all its textures have been released.
+     */
+    class TextureAtlas_Allegro
+    {
+    public:
+        TextureAtlas_Allegro();
+        ~TextureAtlas_Allegro();
+
+        TextureAtlas_Allegro(const TextureAtlas_Allegro&) = delete;
+        TextureAtlas_Allegro& operator=(const TextureAtlas_Allegro&) = delete;
+
+        /**
+         * @brief Checks if a texture of the given size is small enough to be packed.
+         *
+         * @param width The width of the texture.
+         * @param height The height of the texture.
+         */
+        [[nodiscard]] bool CanPack(PiInt32 width, PiInt32 height) const;
+
+        /**
+         * @brief Copies the given bitmap into an atlas page.
+         *
+         * This method changes the target bitmap while copying. Any pending draw
+         * operation using the atlas pages must be flushed before calling it.
+         *
+         * @param bitmap The bitmap to copy. It is left untouched.
+         * @param page Receives the page in which the bitmap has been copied.
+         * @param region Receives the place of the bitmap in the page.
+         *
+         * @return A sub-bitmap of the page, or nullptr when the bitmap can't be packed.
+         * The sub-bitmap must be destroyed before calling TextureAtlas_Allegro::Release().
+         */
+        ALLEGRO_BITMAP* Add(ALLEGRO_BITMAP* bitmap, ALLEGRO_BITMAP*& page, Rect& region);
+
+        /**
+         * @brief Releases a texture previously added to the given page.
+         *
+         * @param page The page of the texture.
+         */
+        void Release(ALLEGRO_BITMAP* page);
+
+        /**
+         * @brief Gets the occupancy statistics of the atlas.
+         */
+        [[nodiscard]] BaseRenderer::TextureAtlasStats GetStats() const;
+
+    private:
+        struct Page
+        {
+            ALLEGRO_BITMAP* bitmap;
+            AtlasPacker packer;
+            PiUInt32 textures;
+        };
+
+        std::vector<Page> _pages;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_TEXTURE_ATLAS_H
@@ -0,0 +1,259 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Config/Config.h>
+
+#include <Core/Allegro5/Renderer/TextureDiskCache.h>
+#include <Core/MappedFile.h>
+
+#include <allegro5/allegro_memfile.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace SparkyStudios::UI::Pixel
+{
+    static constexpr char kCacheMagic[4] = { 'P', 'I', 'T', 'X' };
+    static constexpr PiUInt32 kCacheVersion = 1;
+
+    // Cache files are only read on the machine which wrote them, the header is stored in the native byte order.
+    struct CacheHeader
+    {
+        char magic[4];
+        PiUInt32 version;
+        PiUInt32 width;
+        PiUInt32 height;
+        PiUInt64 stamp;
+        PiUInt64 size;
+        PiUInt32 nameLength;
+        PiUInt32 reserved;
+    };
+
+    static PiUInt64 HashBytes(const void* data, PiUInt64 size)
+    {
+        // 64 bits FNV-1a, stable across runs and platforms.
+        const auto* bytes = static_cast<const PiUInt8*>(data);
+        PiUInt64 hash = 14695981039346656037ull;
+
+        for (PiUInt64 i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // The pixels start on a 16 bytes boundary after the header and the source name.
+    static PiUInt64 GetPixelsOffset(PiUInt32 nameLength)
+    {
+        return (sizeof(CacheHeader) + nameLength + 15) & ~static_cast<PiUInt64>(15);
+    }
+
+    TextureDiskCache_Allegro::TextureDiskCache_Allegro()
+        : _writes(0)
+    {}
+
+    void TextureDiskCache_Allegro::SetDirectory(const PiString& directory)
+    {
+        _directory = directory;
+
+        if (!_directory.empty())
+        {
+            std::error_code error;
+            std::filesystem::create_directories(_directory, error);
+        }
+    }
+
+    const PiString& TextureDiskCache_Allegro::GetDirectory() const
+    {
+        return _directory;
+    }
+
+    ALLEGRO_BITMAP* TextureDiskCache_Allegro::Load(const PiString& fileName, const void* data, PiUInt64 size)
+    {
+        Source source;
+
+        if (_directory.empty() || !GetSource(fileName, data, size, source))
+            return Decode(fileName, data, size);
+
+        const PiString cacheFileName = GetCacheFileName(source);
+
+        {
+            std::lock_guard<std::mutex> lock(_filesMutex);
+
+            if (ALLEGRO_BITMAP* bitmap = Read(cacheFileName, source); bitmap != nullptr)
+                return bitmap;
+        }
+
+        ALLEGRO_BITMAP* bitmap = Decode(fileName, data, size);
+
+        if (bitmap != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_filesMutex);
+            Write(cacheFileName, source, bitmap);
+        }
+
+        return bitmap;
+    }
+
+    ALLEGRO_BITMAP* TextureDiskCache_Allegro::Decode(const PiString& fileName, const void* data, PiUInt64 size)
+    {
+        if (data == nullptr)
+            return al_load_bitmap(fileName.c_str());
+
+        ALLEGRO_FILE* file = al_open_memfile(const_cast<void*>(data), static_cast<int64_t>(size), "r");
+
+        if (file == nullptr)
+            return nullptr;
+
+        // The file extension tells the image format.
+        const std::size_t dot = fileName.rfind('.');
+        ALLEGRO_BITMAP* bitmap = al_load_bitmap_f(file, dot != PiString::npos ? fileName.c_str() + dot : nullptr);
+        al_fclose(file);
+
+        return bitmap;
+    }
+
+    bool TextureDiskCache_Allegro::GetSource(const PiString& fileName, const void* data, PiUInt64 size, Source& source)
+    {
+        source.name = fileName;
+
+        if (data != nullptr)
+        {
+            source.stamp = HashBytes(data, size);
+            source.size = size;
+            return true;
+        }
+
+        std::error_code error;
+        const auto time = std::filesystem::last_write_time(fileName, error);
+
+        if (error)
+            return false;
+
+        source.stamp = static_cast<PiUInt64>(time.time_since_epoch().count());
+        source.size = std::filesystem::file_size(fileName, error);
+
+        return !error;
+    }
+
+    PiString TextureDiskCache_Allegro::GetCacheFileName(const Source& source) const
+    {
+        const PiUInt64 hash = HashBytes(source.name.data(), source.name.size());
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.pitx", static_cast<unsigned long long>(hash));
+
+        return _directory + PI_NATIVE_PATH_SEP + name;
+    }
+
+    ALLEGRO_BITMAP* TextureDiskCache_Allegro::Read(const PiString& cacheFileName, const Source& source)
+    {
+        MappedFile file;
+
+        if (!file.Open(cacheFileName) || file.GetSize() < sizeof(CacheHeader))
+            return nullptr;
+
+        CacheHeader header;
+        std::memcpy(&header, file.GetData(), sizeof(CacheHeader));
+
+        const PiUInt64 offset = GetPixelsOffset(header.nameLength);
+        const PiUInt64 rowSize = static_cast<PiUInt64>(header.width) * 4;
+
+        // A stale or corrupted file is replaced by the next write.
+        if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kCacheVersion ||
+            header.stamp != source.stamp || header.size != source.size || header.nameLength != source.name.size() ||
+            file.GetSize() != offset + rowSize * header.height ||
+            std::memcmp(file.GetData() + sizeof(CacheHeader), source.name.data(), header.nameLength) != 0)
+            return nullptr;
+
+        ALLEGRO_BITMAP* bitmap = al_create_bitmap(static_cast<int>(header.width), static_cast<int>(header.height));
+
+        if (bitmap == nullptr)
+            return nullptr;
+
+        ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+
+        if (region == nullptr)
+        {
+            al_destroy_bitmap(bitmap);
+            return nullptr;
+        }
+
+        const PiUInt8* pixels = file.GetData() + offset;
+        auto* row = static_cast<PiUInt8*>(region->data);
+
+        for (PiUInt32 y = 0; y < header.height; ++y, pixels += rowSize, row += region->pitch)
+            std::memcpy(row, pixels, rowSize);
+
+        al_unlock_bitmap(bitmap);
+
+        return bitmap;
+    }
+
+    void TextureDiskCache_Allegro::Write(const PiString& cacheFileName, const Source& source, ALLEGRO_BITMAP* bitmap)
+    {
+        ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+
+        if (region == nullptr)
+            return;
+
+        CacheHeader header = {};
+        std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+        header.version = kCacheVersion;
+        header.width = static_cast<PiUInt32>(al_get_bitmap_width(bitmap));
+        header.height = static_cast<PiUInt32>(al_get_bitmap_height(bitmap));
+        header.stamp = source.stamp;
+        header.size = source.size;
+        header.nameLength = static_cast<PiUInt32>(source.name.size());
+
+        const PiUInt64 rowSize = static_cast<PiUInt64>(header.width) * 4;
+        const char padding[16] = {};
+
+        // Written aside then renamed, so that other threads and processes never read a partial file.
+        const PiString tempFileName = cacheFileName + "." + std::to_string(_writes++) + ".tmp";
+
+        {
+            std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+            file.write(source.name.data(), static_cast<std::streamsize>(source.name.size()));
+            file.write(padding, static_cast<std::streamsize>(GetPixelsOffset(header.nameLength) - sizeof(CacheHeader) - header.nameLength));
+
+            const auto* row = static_cast<const char*>(region->data);
+
+            for (PiUInt32 y = 0; y < header.height; ++y, row += region->pitch)
+                file.write(row, static_cast<std::streamsize>(rowSize));
+
+            if (!file)
+            {
+                file.close();
+                std::remove(tempFileName.c_str());
+                al_unlock_bitmap(bitmap);
+                return;
+            }
+        }
+
+        al_unlock_bitmap(bitmap);
+
+        std::error_code error;
+        std::filesystem::rename(tempFileName, cacheFileName, error);
+
+        if (error)
+            std::filesystem::remove(tempFileName, error);
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,114 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_TEXTURE_DISK_CACHE_H
+#define PIXEL_UI_TEXTURE_DISK_CACHE_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <allegro5/allegro.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief On-disk cache of decoded texture pixels.
+     *
+     * Each decoded image is stored as raw RGBA pixels in a file named after the
+     * hash of its source path. The file records the modification time and size of
+     * the source file, or the hash of the source content for resources read from
+     * memory, and is decoded again when they change. Cache files are mapped in
+     * memory and copied in a locked bitmap, without decoding.
+     *
+     * Loading is thread safe: cache files are read and written by one thread at a time,
+     * while images are decoded in parallel. The cache directory must be set before
+     * loading textures.
+     */
+    class TextureDiskCache_Allegro
+    {
+    public:
+        TextureDiskCache_Allegro();
+
+        /**
+         * @brief Sets the directory of the cache files. An empty directory disables the cache, which is the default.
+         */
+        void SetDirectory(const PiString& directory);
+
+        [[nodiscard]] const PiString& GetDirectory() const;
+
+        /**
+         * @brief Loads a bitmap from the cache, or decodes it and stores it in the cache.
+         *
+         * The bitmap is created with the current new bitmap flags.
+         *
+         * @param fileName The path of the image file, its extension tells the image format.
+         * @param data The content of the image file, or nullptr to read the file.
+         * @param size The size of the content, in bytes.
+         *
+         * @return The bitmap, or nullptr if the image couldn't be loaded.
+         */
+        ALLEGRO_BITMAP* Load(const PiString& fileName, const void* data, PiUInt64 size);
+
+    private:
+        /**
+         * @brief What the cached pixels were decoded from.
+         */
+        struct Source
+        {
+            PiString name;
+
+            // The modification time of the file, or the hash of the content read from memory.
+            PiUInt64 stamp;
+            PiUInt64 size;
+        };
+
+        /**
+         * @brief Decodes an image, without the cache.
+         */
+        static ALLEGRO_BITMAP* Decode(const PiString& fileName, const void* data, PiUInt64 size);
+
+        /**
+         * @brief Identifies the source of an image.
+         *
+         * @return Whether the source file exists.
+         */
+        static bool GetSource(const PiString& fileName, const void* data, PiUInt64 size, Source& source);
+
+        [[nodiscard]] PiString GetCacheFileName(const Source& source) const;
+
+        /**
+         * @brief Creates a bitmap from a cache file.
+         *
+         * @return The bitmap, or nullptr if the cache file is missing or stale.
+         */
+        static ALLEGRO_BITMAP* Read(const PiString& cacheFileName, const Source& source);
+
+        /**
+         * @brief Writes the pixels of a bitmap in a cache file.
+         */
+        void Write(const PiString& cacheFileName, const Source& source, ALLEGRO_BITMAP* bitmap);
+
+        PiString _directory;
+        std::atomic<PiUInt32> _writes;
+
+        // Serializes the accesses to the cache files, shared by the texture decoders and the preload workers.
+        std::mutex _filesMutex;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_TEXTURE_DISK_CACHE_H
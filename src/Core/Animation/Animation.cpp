@@ -16,9 +16,12 @@
 
 #if PI_ENABLE_ANIMATION
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <SparkyStudios/UI/Pixel/Core/Utility.h>
+#include <SparkyStudios/UI/Pixel/Widgets/Widget.h>
 
 namespace SparkyStudios::UI::Pixel
 {
@@ -215,6 +218,13 @@ namespace SparkyStudios::UI::Pixel
         for (auto it = gAnimationList.begin(); it != gAnimationList.end();)
         {
             Animation* animation = *it;
+
+            if (!animation->NeedsUpdate())
+            {
+                ++it;
+                continue;
+            }
+
             animation->Update(time);
 
             if (animation->Finished())
@@ -229,6 +239,24 @@ namespace SparkyStudios::UI::Pixel
         }
     }
 
+    PiTime Animation::GetNextTickTime(PiTime time)
+    {
+        PiTime next = std::numeric_limits<PiTime>::infinity();
+
+        for (const Animation* animation : gAnimationList)
+        {
+            if (!animation->NeedsUpdate())
+                continue;
+
+            next = std::min(next, std::max(time, animation->GetNextUpdateTime(time)));
+
+            if (next <= time)
+                break;
+        }
+
+        return next;
+    }
+
     Animation::Animation(PiTime duration, PiTime delay, Animation::TransitionFunction function, bool loop)
         : m_started(false)
         , m_finished(false)
@@ -238,6 +266,7 @@ namespace SparkyStudios::UI::Pixel
         , m_ease(function)
         , m_customCurve(gLinearTransition)
         , m_loop(loop)
+        , m_progress(-1.0)
         , m_widget(nullptr)
     {}
 
@@ -284,6 +313,20 @@ namespace SparkyStudios::UI::Pixel
         return m_finished;
     }
 
+    PiTime Animation::GetNextUpdateTime(PiTime time) const
+    {
+        // Waiting for the start delay to elapse.
+        if (m_started && time < m_start)
+            return m_start;
+
+        return time;
+    }
+
+    bool Animation::NeedsUpdate() const
+    {
+        return true;
+    }
+
     void Animation::Start(PiTime time)
     {
         m_start = time + m_delay;
@@ -307,10 +350,20 @@ namespace SparkyStudios::UI::Pixel
         const PiTime percent = Clamp(elapsed / m_duration, 0.0, 1.0);
         const PiTime eased = GetTransition().Ease(percent);
 
+        // Animations change the state of the widget directly, which doesn't always redraw it.
+        bool advanced = eased != m_progress;
+        m_progress = eased;
+
         Run(eased);
 
         if (percent >= 1.0)
+        {
             Finish(time);
+            advanced = true;
+        }
+
+        if (advanced && m_widget != nullptr)
+            m_widget->Redraw();
     }
 
     void Animation::Finish(PiTime time)
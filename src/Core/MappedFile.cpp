@@ -0,0 +1,140 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/MappedFile.h>
+
+#if defined(PI_WINDOWS)
+#ifndef VC_EXTRALEAN
+#define VC_EXTRALEAN
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::UI::Pixel
+{
+    MappedFile::MappedFile()
+        : _data(nullptr)
+        , _size(0)
+#if defined(PI_WINDOWS)
+        , _mapping(nullptr)
+#endif
+    {}
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const PiString& path)
+    {
+        Close();
+
+#if defined(PI_WINDOWS)
+        HANDLE file = CreateFileA(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // The mapping keeps the file open.
+        _mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (_mapping == nullptr)
+            return false;
+
+        _data = static_cast<const PiUInt8*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (_data == nullptr)
+        {
+            CloseHandle(_mapping);
+            _mapping = nullptr;
+            return false;
+        }
+
+        _size = static_cast<PiUInt64>(size.QuadPart);
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+
+        if (file < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+
+        // The mapping keeps the file open.
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+
+        if (data == MAP_FAILED)
+            return false;
+
+        _data = static_cast<const PiUInt8*>(data);
+        _size = static_cast<PiUInt64>(info.st_size);
+#endif
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (_data == nullptr)
+            return;
+
+#if defined(PI_WINDOWS)
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+#else
+        munmap(const_cast<PiUInt8*>(_data), static_cast<size_t>(_size));
+#endif
+
+        _data = nullptr;
+        _size = 0;
+    }
+
+    bool MappedFile::IsOpen() const
+    {
+        return _data != nullptr;
+    }
+
+    const PiUInt8* MappedFile::GetData() const
+    {
+        return _data;
+    }
+
+    PiUInt64 MappedFile::GetSize() const
+    {
+        return _size;
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,79 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_MAPPEDFILE_H
+#define PIXEL_UI_MAPPEDFILE_H
+
+#include <SparkyStudios/UI/Pixel/Config/Config.h>
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A read-only view of a whole file mapped in memory.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile();
+
+        /**
+         * @brief Unmaps the file, if any.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps a file in memory, unmapping the previous one.
+         *
+         * @param path The path of the file to map.
+         * @return Whether the file could be mapped.
+         */
+        bool Open(const PiString& path);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void Close();
+
+        /**
+         * @brief Checks if a file is mapped.
+         */
+        [[nodiscard]] bool IsOpen() const;
+
+        /**
+         * @brief Gets the content of the mapped file.
+         */
+        [[nodiscard]] const PiUInt8* GetData() const;
+
+        /**
+         * @brief Gets the size of the mapped file, in bytes.
+         */
+        [[nodiscard]] PiUInt64 GetSize() const;
+
+    private:
+        const PiUInt8* _data;
+        PiUInt64 _size;
+
+#if defined(PI_WINDOWS)
+        void* _mapping;
+#endif
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_MAPPEDFILE_H
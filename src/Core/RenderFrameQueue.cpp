@@ -0,0 +1,95 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/RenderFrameQueue.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    RenderFrameQueue::RenderFrameQueue(PiUInt32 frameCount)
+        : _closed(false)
+    {
+        _frames.reserve(frameCount);
+
+        for (PiUInt32 i = 0; i < frameCount; i++)
+        {
+            _frames.push_back(new RenderFrame());
+            _free.push_back(_frames.back());
+        }
+    }
+
+    RenderFrameQueue::~RenderFrameQueue()
+    {
+        for (auto&& frame : _frames)
+            delete frame;
+    }
+
+    RenderFrame* RenderFrameQueue::AcquireFree()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _frameFree.wait(lock, [this] { return _closed || !_free.empty(); });
+
+        if (_closed)
+            return nullptr;
+
+        RenderFrame* frame = _free.front();
+        _free.pop_front();
+
+        return frame;
+    }
+
+    void RenderFrameQueue::Submit(RenderFrame* frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _submitted.push_back(frame);
+        }
+
+        _frameSubmitted.notify_one();
+    }
+
+    RenderFrame* RenderFrameQueue::AcquireSubmitted()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _frameSubmitted.wait(lock, [this] { return _closed || !_submitted.empty(); });
+
+        if (_submitted.empty())
+            return nullptr;
+
+        RenderFrame* frame = _submitted.front();
+        _submitted.pop_front();
+
+        return frame;
+    }
+
+    void RenderFrameQueue::Release(RenderFrame* frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _free.push_back(frame);
+        }
+
+        _frameFree.notify_one();
+    }
+
+    void RenderFrameQueue::Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+        }
+
+        _frameFree.notify_all();
+        _frameSubmitted.notify_all();
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,126 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_RENDERFRAMEQUEUE_H
+#define PIXEL_UI_RENDERFRAMEQUEUE_H
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A frame recorded by the UI thread, waiting to be painted by the render thread.
+     */
+    struct RenderFrame
+    {
+        /**
+         * @brief The draw operations of the frame.
+         */
+        DisplayList list;
+
+        /**
+         * @brief The region of the canvas rendered in the frame.
+         */
+        Rect region;
+
+        /**
+         * @brief Whether only the rendered region is presented, the rest of the backbuffer being preserved.
+         */
+        bool partial = false;
+
+        /**
+         * @brief The scale of the canvas.
+         */
+        PiReal32 scale = 1.0f;
+
+        /**
+         * @brief Whether the display has been resized since the previous frame.
+         */
+        bool acknowledgeResize = false;
+    };
+
+    /**
+     * @brief A bounded queue of frames exchanged between the UI thread and the render thread.
+     *
+     * The queue owns a fixed number of frames. The UI thread acquires a free frame,
+     * records it and submits it. The render thread acquires the submitted frames in
+     * order, paints them and releases them. When every frame is in use, the UI thread
+     * waits for the render thread to release one.
+     */
+    class RenderFrameQueue
+    {
+    public:
+        /**
+         * @brief Creates the frames of the queue.
+         *
+         * @param frameCount The number of frames, 2 for double buffering, 3 for triple buffering.
+         */
+        explicit RenderFrameQueue(PiUInt32 frameCount);
+
+        /**
+         * @brief Deletes the frames of the queue.
+         */
+        ~RenderFrameQueue();
+
+        RenderFrameQueue(const RenderFrameQueue&) = delete;
+        RenderFrameQueue& operator=(const RenderFrameQueue&) = delete;
+
+        /**
+         * @brief Waits for a free frame.
+         *
+         * @return The frame to record, or nullptr if the queue has been closed.
+         */
+        RenderFrame* AcquireFree();
+
+        /**
+         * @brief Queues a recorded frame to be painted.
+         */
+        void Submit(RenderFrame* frame);
+
+        /**
+         * @brief Waits for the next submitted frame.
+         *
+         * @return The frame to paint, or nullptr if the queue has been closed and every frame has been painted.
+         */
+        RenderFrame* AcquireSubmitted();
+
+        /**
+         * @brief Gives back a painted frame, so it can be recorded again.
+         */
+        void Release(RenderFrame* frame);
+
+        /**
+         * @brief Wakes up the waiting threads and stops accepting new frames.
+         */
+        void Close();
+
+    private:
+        std::vector<RenderFrame*> _frames;
+        std::deque<RenderFrame*> _free;
+        std::deque<RenderFrame*> _submitted;
+        std::mutex _mutex;
+        std::condition_variable _frameFree;
+        std::condition_variable _frameSubmitted;
+        bool _closed;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_RENDERFRAMEQUEUE_H
@@ -0,0 +1,175 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/AtlasPacker.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace SparkyStudios::UI::Pixel
+{
+    AtlasPacker::AtlasPacker(PiInt32 width, PiInt32 height, PiInt32 padding)
+        : _width(width)
+        , _height(height)
+        , _padding(padding)
+        , _count(0)
+        , _usedArea(0)
+    {
+        Clear();
+    }
+
+    bool AtlasPacker::Pack(PiInt32 width, PiInt32 height, Rect& region)
+    {
+        if (width <= 0 || height <= 0)
+            return false;
+
+        const PiInt32 w = width + _padding;
+        const PiInt32 h = height + _padding;
+
+        PiInt32 bestY = std::numeric_limits<PiInt32>::max();
+        PiInt32 bestWidth = std::numeric_limits<PiInt32>::max();
+        std::size_t bestIndex = _skyline.size();
+
+        // Bottom-left: keep the lowest position, then the narrowest skyline level.
+        for (std::size_t i = 0; i < _skyline.size(); ++i)
+        {
+            PiInt32 y;
+            if (!Fit(i, w, h, y))
+                continue;
+
+            if (y < bestY || (y == bestY && _skyline[i].width < bestWidth))
+            {
+                bestY = y;
+                bestWidth = _skyline[i].width;
+                bestIndex = i;
+            }
+        }
+
+        if (bestIndex == _skyline.size())
+            return false;
+
+        region = Rect(_skyline[bestIndex].x, bestY, width, height);
+        AddSkylineLevel(bestIndex, region.x, bestY, w, h);
+
+        _count++;
+        _usedArea += static_cast<PiUInt64>(w) * h;
+
+        return true;
+    }
+
+    void AtlasPacker::Clear()
+    {
+        _skyline.clear();
+        _skyline.push_back({ 0, 0, _width });
+
+        _count = 0;
+        _usedArea = 0;
+    }
+
+    PiInt32 AtlasPacker::GetWidth() const
+    {
+        return _width;
+    }
+
+    PiInt32 AtlasPacker::GetHeight() const
+    {
+        return _height;
+    }
+
+    PiUInt32 AtlasPacker::GetCount() const
+    {
+        return _count;
+    }
+
+    PiUInt64 AtlasPacker::GetUsedArea() const
+    {
+        return _usedArea;
+    }
+
+    PiReal32 AtlasPacker::GetOccupancy() const
+    {
+        if (_width <= 0 || _height <= 0)
+            return 0.0f;
+
+        return static_cast<PiReal32>(static_cast<PiReal64>(_usedArea) / (static_cast<PiReal64>(_width) * _height));
+    }
+
+    bool AtlasPacker::Fit(std::size_t index, PiInt32 width, PiInt32 height, PiInt32& y) const
+    {
+        // Padding may be cut on the right and bottom edges of the page.
+        const PiInt32 x = _skyline[index].x;
+        if (x + width - _padding > _width)
+            return false;
+
+        PiInt32 remaining = width;
+        y = _skyline[index].y;
+
+        for (std::size_t i = index; remaining > 0; ++i)
+        {
+            if (i == _skyline.size())
+                return x + width - _padding <= _width;
+
+            y = std::max(y, _skyline[i].y);
+
+            if (y + height - _padding > _height)
+                return false;
+
+            remaining -= _skyline[i].width;
+        }
+
+        return true;
+    }
+
+    void AtlasPacker::AddSkylineLevel(std::size_t index, PiInt32 x, PiInt32 y, PiInt32 width, PiInt32 height)
+    {
+        _skyline.insert(_skyline.begin() + index, { x, y + height, width });
+
+        // Shrink or remove the levels covered by the new one.
+        for (std::size_t i = index + 1; i < _skyline.size();)
+        {
+            const PiInt32 end = _skyline[i - 1].x + _skyline[i - 1].width;
+
+            if (_skyline[i].x >= end)
+                break;
+
+            const PiInt32 shrink = end - _skyline[i].x;
+            _skyline[i].x += shrink;
+            _skyline[i].width -= shrink;
+
+            if (_skyline[i].width > 0)
+                break;
+
+            _skyline.erase(_skyline.begin() + i);
+        }
+
+        // The last level may overflow the page when the padding was cut.
+        SkylineNode& last = _skyline.back();
+        if (last.x + last.width > _width)
+            last.width = _width - last.x;
+
+        // Merge neighbour levels of the same height.
+        for (std::size_t i = 0; i + 1 < _skyline.size();)
+        {
+            if (_skyline[i].y == _skyline[i + 1].y)
+            {
+                _skyline[i].width += _skyline[i + 1].width;
+                _skyline.erase(_skyline.begin() + i + 1);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+} // namespace SparkyStudios::UI::Pixel
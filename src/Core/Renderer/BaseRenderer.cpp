@@ -12,9 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <cmath>
-
+#include <SparkyStudios/UI/Pixel/Core/Platform.h>
 #include <SparkyStudios/UI/Pixel/Core/Renderer/BaseRenderer.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
 #include <SparkyStudios/UI/Pixel/Core/Utility.h>
 
 namespace SparkyStudios::UI::Pixel
@@ -23,23 +23,151 @@ namespace SparkyStudios::UI::Pixel
         : m_scale(1.0f)
         , _paths(paths)
         , _renderOffset(Point(0, 0))
+        , _batchingEnabled(true)
+        , _displayListsEnabled(false)
+        , _displayListRecorder(nullptr)
     {}
 
     BaseRenderer::~BaseRenderer()
     {
         if (GetCTT())
             GetCTT()->ShutDown();
+
+        delete _displayListRecorder;
     }
 
     void BaseRenderer::Init()
     {}
 
     void BaseRenderer::Begin()
-    {}
+    {
+        m_frameStats = FrameStats();
+        _clipStack.clear();
+    }
 
     void BaseRenderer::End()
+    {
+        Flush();
+    }
+
+    void BaseRenderer::Flush()
+    {}
+
+    void BaseRenderer::SetBatchingEnabled(bool enabled)
+    {
+        if (_batchingEnabled == enabled)
+            return;
+
+        Flush();
+        _batchingEnabled = enabled;
+    }
+
+    bool BaseRenderer::IsBatchingEnabled() const
+    {
+        return _batchingEnabled;
+    }
+
+    void BaseRenderer::SetDisplayListsEnabled(bool enabled)
+    {
+        _displayListsEnabled = enabled;
+    }
+
+    bool BaseRenderer::IsDisplayListsEnabled() const
+    {
+        return _displayListsEnabled;
+    }
+
+    DisplayListRecorder* BaseRenderer::GetDisplayListRecorder()
+    {
+        if (!_displayListsEnabled)
+            return nullptr;
+
+        if (_displayListRecorder == nullptr)
+            _displayListRecorder = new DisplayListRecorder(_paths, this);
+
+        return _displayListRecorder;
+    }
+
+    const BaseRenderer::FrameStats& BaseRenderer::GetFrameStats() const
+    {
+        return m_frameStats;
+    }
+
+    void BaseRenderer::AddCulledWidgets(PiUInt32 count)
+    {
+        m_frameStats.culledWidgets += count;
+    }
+
+    BaseRenderer::TextureAtlasStats BaseRenderer::GetTextureAtlasStats() const
+    {
+        return TextureAtlasStats();
+    }
+
+    BaseRenderer::ShapeCacheStats BaseRenderer::GetShapeCacheStats() const
+    {
+        return ShapeCacheStats();
+    }
+
+    void BaseRenderer::SetTextureBudget(PiUInt64 bytes)
+    {}
+
+    PiUInt64 BaseRenderer::GetTextureBudget() const
+    {
+        return 0;
+    }
+
+    BaseRenderer::TextureCacheStats BaseRenderer::GetTextureCacheStats() const
+    {
+        return TextureCacheStats();
+    }
+
+    void BaseRenderer::SetTextureDiskCacheDirectory(const PiString& directory)
     {}
 
+    PiString BaseRenderer::GetTextureDiskCacheDirectory() const
+    {
+        return PiString();
+    }
+
+    std::vector<BaseRenderer::PreloadTiming> BaseRenderer::Preload(const std::vector<Font>& fonts, const std::vector<Texture>& textures)
+    {
+        std::vector<PreloadTiming> timings;
+        timings.reserve(fonts.size() + textures.size());
+
+        for (auto&& font : fonts)
+        {
+            PreloadTiming timing;
+            timing.type = ResourcePaths::Type::Font;
+            timing.name = font.facename + " " + std::to_string(static_cast<PiUInt32>(font.size));
+
+            const PiTime start = Platform::GetTimeInSeconds();
+            timing.status = LoadFont(font);
+            timing.decodeTime = Platform::GetTimeInSeconds() - start;
+
+            timings.push_back(timing);
+        }
+
+        for (auto&& texture : textures)
+        {
+            PreloadTiming timing;
+            timing.type = ResourcePaths::Type::Texture;
+            timing.name = texture.name;
+
+            const PiTime start = Platform::GetTimeInSeconds();
+            timing.status = LoadTexture(texture);
+            timing.decodeTime = Platform::GetTimeInSeconds() - start;
+
+            timings.push_back(timing);
+        }
+
+        return timings;
+    }
+
+    TextMeasureCache& BaseRenderer::GetTextMeasureCache()
+    {
+        return m_measureCache;
+    }
+
     IResourceLoader& BaseRenderer::GetLoader()
     {
         return *reinterpret_cast<IResourceLoader*>(this);
@@ -91,6 +219,25 @@ namespace SparkyStudios::UI::Pixel
         _rectClipRegion = out;
     }
 
+    void BaseRenderer::PushClip(const Rect& rect)
+    {
+        _clipStack.push_back(_rectClipRegion);
+        AddClipRegion(rect);
+        StartClip();
+    }
+
+    void BaseRenderer::PopClip()
+    {
+        PI_ASSERT(!_clipStack.empty());
+
+        if (_clipStack.empty())
+            return;
+
+        _rectClipRegion = _clipStack.back();
+        _clipStack.pop_back();
+        StartClip();
+    }
+
     bool BaseRenderer::ClipRegionVisible()
     {
         if (_rectClipRegion.w <= 0 || _rectClipRegion.h <= 0)
@@ -176,7 +323,7 @@ namespace SparkyStudios::UI::Pixel
 
     void BaseRenderer::DrawString(const Font& font, Point pos, const PiString& text)
     {
-        const PiReal32 size = font.size * GetScale();
+        const PiReal32 size = font.size;
 
         for (PiUInt32 i = 0; i < text.length(); i++)
         {
@@ -222,8 +369,8 @@ namespace SparkyStudios::UI::Pixel
     Size BaseRenderer::MeasureText(const Font& font, const PiString& text)
     {
         Size p;
-        p.w = font.size * GetScale() * text.length() * 0.4f;
-        p.h = font.size * GetScale();
+        p.w = font.size * text.length() * 0.4f;
+        p.h = font.size;
         return p;
     }
 
@@ -231,15 +378,11 @@ namespace SparkyStudios::UI::Pixel
     {
         x += _renderOffset.x;
         y += _renderOffset.y;
-        x = std::ceil(static_cast<PiReal32>(x) * m_scale);
-        y = std::ceil(static_cast<PiReal32>(y) * m_scale);
     }
 
     void BaseRenderer::Translate(Rect& rect)
     {
         Translate(rect.x, rect.y);
-        rect.w = std::ceil(static_cast<PiReal32>(rect.w) * m_scale);
-        rect.h = std::ceil(static_cast<PiReal32>(rect.h) * m_scale);
     }
 
     void BaseRenderer::SetRenderOffset(const Point& offset)
@@ -288,6 +431,11 @@ namespace SparkyStudios::UI::Pixel
         return false;
     }
 
+    bool BaseRenderer::BeginContext(MainWindow* window, const Rect& region)
+    {
+        return BeginContext(window);
+    }
+
     bool BaseRenderer::EndContext(MainWindow* window)
     {
         return false;
@@ -298,6 +446,16 @@ namespace SparkyStudios::UI::Pixel
         return false;
     }
 
+    bool BaseRenderer::PresentContext(MainWindow* window, const Rect& region)
+    {
+        return PresentContext(window);
+    }
+
+    bool BaseRenderer::CanPresentRegion(MainWindow* window)
+    {
+        return false;
+    }
+
     ICacheToTexture* BaseRenderer::GetCTT()
     {
         return nullptr;
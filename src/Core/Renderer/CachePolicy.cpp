@@ -0,0 +1,54 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/CachePolicy.h>
+#include <SparkyStudios/UI/Pixel/Widgets/Widget.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    DefaultCachePolicy::DefaultCachePolicy(PiUInt32 interval, PiUInt32 minPrimitives, PiReal32 maxChangeRate)
+        : _interval(interval)
+        , _minPrimitives(minPrimitives)
+        , _maxChangeRate(maxChangeRate)
+    {}
+
+    PiUInt32 DefaultCachePolicy::GetEvaluationInterval() const
+    {
+        return _interval;
+    }
+
+    bool DefaultCachePolicy::IsCandidate(const Widget* widget) const
+    {
+        // Leaf widgets are cheap, caching them would only add a draw call.
+        return !widget->GetChildren().empty();
+    }
+
+    ICachePolicy::Decision DefaultCachePolicy::Evaluate(const Widget* widget, const WidgetRenderStats& stats, bool cached)
+    {
+        if (stats.frames == 0)
+            return Decision::Keep;
+
+        const PiReal32 changeRate = static_cast<PiReal32>(stats.changes) / static_cast<PiReal32>(stats.frames);
+
+        // Uncache only above twice the change rate, so widgets don't flip between both states.
+        if (cached)
+            return changeRate > _maxChangeRate * 2.0f ? Decision::Uncache : Decision::Keep;
+
+        if (stats.renders == 0 || changeRate > _maxChangeRate)
+            return Decision::Keep;
+
+        const PiUInt64 primitives = stats.primitives / stats.renders;
+        return primitives >= _minPrimitives ? Decision::Cache : Decision::Keep;
+    }
+} // namespace SparkyStudios::UI::Pixel
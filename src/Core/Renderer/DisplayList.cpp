@@ -0,0 +1,383 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    void DisplayList::Clear()
+    {
+        _commands.clear();
+        _fonts.clear();
+        _textures.clear();
+        _texts.clear();
+    }
+
+    bool DisplayList::IsEmpty() const
+    {
+        return _commands.empty();
+    }
+
+    std::size_t DisplayList::GetCommandCount() const
+    {
+        return _commands.size();
+    }
+
+    void DisplayList::Replay(BaseRenderer* renderer) const
+    {
+        const Point offset = renderer->GetRenderOffset();
+        const Rect clip = renderer->ClipRegion();
+        bool clipped = false;
+
+        for (const Command& command : _commands)
+        {
+            switch (command.operation)
+            {
+            case Operation::SetRenderOffset:
+                renderer->SetRenderOffset(command.points[0]);
+                break;
+
+            case Operation::SetClipRegion:
+                renderer->SetClipRegion(command.rect);
+                renderer->StartClip();
+                clipped = true;
+                break;
+
+            case Operation::SetDrawColor:
+                renderer->SetDrawColor(command.color);
+                break;
+
+            case Operation::DrawFilledRect:
+                renderer->DrawFilledRect(command.rect, command.radii);
+                break;
+
+            case Operation::DrawTexturedRect:
+                renderer->DrawTexturedRect(
+                    _textures[command.param], command.rect, command.uv[0], command.uv[1], command.uv[2], command.uv[3]);
+                break;
+
+            case Operation::DrawLinedRect:
+                renderer->DrawLinedRect(command.rect, command.param, command.radii);
+                break;
+
+            case Operation::DrawPixel:
+                renderer->DrawPixel(command.points[0]);
+                break;
+
+            case Operation::DrawFilledEllipse:
+                renderer->DrawFilledEllipse(command.rect);
+                break;
+
+            case Operation::DrawLinedEllipse:
+                renderer->DrawLinedEllipse(command.rect, command.param);
+                break;
+
+            case Operation::DrawFilledTriangle:
+                renderer->DrawFilledTriangle(command.points[0], command.points[1], command.points[2]);
+                break;
+
+            case Operation::DrawLinedTriangle:
+                renderer->DrawLinedTriangle(command.points[0], command.points[1], command.points[2], command.param);
+                break;
+
+            case Operation::DrawShavedCornerRect:
+                renderer->DrawShavedCornerRect(command.rect, command.param != 0);
+                break;
+
+            case Operation::DrawString:
+                renderer->DrawString(_fonts[command.param], command.points[0], _texts[command.text]);
+                break;
+            }
+        }
+
+        renderer->SetRenderOffset(offset);
+
+        if (clipped)
+        {
+            renderer->SetClipRegion(clip);
+            renderer->StartClip();
+        }
+    }
+
+    DisplayList::Command& DisplayList::Add(Operation operation)
+    {
+        Command& command = _commands.emplace_back();
+        command.operation = operation;
+
+        return command;
+    }
+
+    DisplayListRecorder::DisplayListRecorder(ResourcePaths& paths, BaseRenderer* target)
+        : BaseRenderer(paths)
+        , _target(target)
+        , _targetMutex(nullptr)
+        , _list(nullptr)
+    {}
+
+    void DisplayListRecorder::SetDisplayList(DisplayList* list)
+    {
+        _list = list;
+        _recordedOffset = GetRenderOffset();
+    }
+
+    void DisplayListRecorder::SetTargetMutex(std::mutex* mutex)
+    {
+        _targetMutex = mutex;
+    }
+
+    void DisplayListRecorder::SetDrawColor(const Color& color)
+    {
+        if (_list != nullptr)
+            _list->Add(DisplayList::Operation::SetDrawColor).color = color;
+    }
+
+    void DisplayListRecorder::StartClip()
+    {
+        if (_list != nullptr)
+            _list->Add(DisplayList::Operation::SetClipRegion).rect = ClipRegion();
+    }
+
+    Color DisplayListRecorder::PixelColor(const Texture& texture, const Point& position, const Color& defaultColor)
+    {
+        const auto lock = LockTarget();
+        return _target->PixelColor(texture, position, defaultColor);
+    }
+
+    void DisplayListRecorder::DrawFilledRect(Rect rect, const Size& radii)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawFilledRect);
+        command.rect = rect;
+        command.radii = radii;
+    }
+
+    void DisplayListRecorder::DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawTexturedRect);
+        command.param = static_cast<PiUInt32>(_list->_textures.size());
+        command.rect = rect;
+        command.uv[0] = u1;
+        command.uv[1] = v1;
+        command.uv[2] = u2;
+        command.uv[3] = v2;
+
+        _list->_textures.push_back(texture);
+    }
+
+    void DisplayListRecorder::DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawLinedRect);
+        command.rect = rect;
+        command.param = thickness;
+        command.radii = radii;
+    }
+
+    void DisplayListRecorder::DrawPixel(const Point& position)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+        _list->Add(DisplayList::Operation::DrawPixel).points[0] = position;
+    }
+
+    void DisplayListRecorder::DrawFilledEllipse(Rect rect)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+        _list->Add(DisplayList::Operation::DrawFilledEllipse).rect = rect;
+    }
+
+    void DisplayListRecorder::DrawLinedEllipse(Rect rect, PiUInt32 thickness)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawLinedEllipse);
+        command.rect = rect;
+        command.param = thickness;
+    }
+
+    void DisplayListRecorder::DrawFilledTriangle(Point p1, Point p2, Point p3)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawFilledTriangle);
+        command.points[0] = p1;
+        command.points[1] = p2;
+        command.points[2] = p3;
+    }
+
+    void DisplayListRecorder::DrawLinedTriangle(Point p1, Point p2, Point p3, PiUInt32 thickness)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawLinedTriangle);
+        command.points[0] = p1;
+        command.points[1] = p2;
+        command.points[2] = p3;
+        command.param = thickness;
+    }
+
+    void DisplayListRecorder::DrawShavedCornerRect(Rect rect, bool slight)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawShavedCornerRect);
+        command.rect = rect;
+        command.param = slight ? 1 : 0;
+    }
+
+    void DisplayListRecorder::DrawString(const Font& font, Point pos, const PiString& text)
+    {
+        m_frameStats.primitives++;
+
+        if (_list == nullptr)
+            return;
+
+        RecordOffset();
+
+        DisplayList::Command& command = _list->Add(DisplayList::Operation::DrawString);
+        command.param = static_cast<PiUInt32>(_list->_fonts.size());
+        command.text = static_cast<PiUInt32>(_list->_texts.size());
+        command.points[0] = pos;
+
+        _list->_fonts.push_back(font);
+        _list->_texts.push_back(text);
+    }
+
+    Size DisplayListRecorder::MeasureText(const Font& font, const PiString& text)
+    {
+        const auto lock = LockTarget();
+        return _target->MeasureText(font, text);
+    }
+
+    IResourceLoader::LoadStatus DisplayListRecorder::LoadFont(const Font& font)
+    {
+        const auto lock = LockTarget();
+        return _target->LoadFont(font);
+    }
+
+    void DisplayListRecorder::FreeFont(const Font& font)
+    {
+        const auto lock = LockTarget();
+        _target->FreeFont(font);
+    }
+
+    IResourceLoader::LoadStatus DisplayListRecorder::LoadTexture(const Texture& texture)
+    {
+        const auto lock = LockTarget();
+        return _target->LoadTexture(texture);
+    }
+
+    IResourceLoader::LoadStatus DisplayListRecorder::LoadTextureAsync(const Texture& texture)
+    {
+        const auto lock = LockTarget();
+        return _target->LoadTextureAsync(texture);
+    }
+
+    IResourceLoader::LoadStatus DisplayListRecorder::GetTextureStatus(const Texture& texture) const
+    {
+        const auto lock = LockTarget();
+        return _target->GetTextureStatus(texture);
+    }
+
+    void DisplayListRecorder::FreeTexture(const Texture& texture)
+    {
+        const auto lock = LockTarget();
+        _target->FreeTexture(texture);
+    }
+
+    IResourceLoader::LoadStatus DisplayListRecorder::AcquireTexture(const Texture& texture, bool async)
+    {
+        const auto lock = LockTarget();
+        return _target->AcquireTexture(texture, async);
+    }
+
+    void DisplayListRecorder::ReleaseTexture(const Texture& texture)
+    {
+        const auto lock = LockTarget();
+        _target->ReleaseTexture(texture);
+    }
+
+    TextureData DisplayListRecorder::GetTextureData(const Texture& texture) const
+    {
+        const auto lock = LockTarget();
+        return _target->GetTextureData(texture);
+    }
+
+    std::unique_lock<std::mutex> DisplayListRecorder::LockTarget() const
+    {
+        if (_targetMutex == nullptr)
+            return std::unique_lock<std::mutex>();
+
+        return std::unique_lock<std::mutex>(*_targetMutex);
+    }
+
+    void DisplayListRecorder::RecordOffset()
+    {
+        const Point& offset = GetRenderOffset();
+
+        if (offset.x == _recordedOffset.x && offset.y == _recordedOffset.y)
+            return;
+
+        _list->Add(DisplayList::Operation::SetRenderOffset).points[0] = offset;
+        _recordedOffset = offset;
+    }
+} // namespace SparkyStudios::UI::Pixel
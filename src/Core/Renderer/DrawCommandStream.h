@@ -0,0 +1,288 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_DRAWCOMMANDSTREAM_H
+#define PIXEL_UI_DRAWCOMMANDSTREAM_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <SparkyStudios/UI/Pixel/Graphics/Color.h>
+#include <SparkyStudios/UI/Pixel/Graphics/Point.h>
+#include <SparkyStudios/UI/Pixel/Graphics/Rect.h>
+
+#include <cstring>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief The commands of a recorded draw stream.
+     *
+     * Values are part of the binary format and must never be changed.
+     */
+    enum class DrawCommand : PiUInt8
+    {
+        BeginFrame = 1,
+        EndFrame = 2,
+        SetRenderOffset = 3,
+        SetClipRegion = 4,
+        SetScale = 5,
+        SetDrawColor = 6,
+        StartClip = 7,
+        EndClip = 8,
+        DefineFont = 9,
+        DefineTexture = 10,
+        DrawFilledRect = 11,
+        DrawTexturedRect = 12,
+        DrawLinedRect = 13,
+        DrawPixel = 14,
+        DrawFilledEllipse = 15,
+        DrawLinedEllipse = 16,
+        DrawFilledTriangle = 17,
+        DrawLinedTriangle = 18,
+        DrawShavedCornerRect = 19,
+        DrawString = 20,
+    };
+
+    /**
+     * @brief Writes draw commands into a binary stream.
+     *
+     * Integers are stored as zigzag encoded variable length values,
+     * which keeps the usual small UI coordinates on one or two bytes.
+     */
+    class DrawCommandWriter
+    {
+    public:
+        explicit DrawCommandWriter(std::vector<PiUInt8>& stream)
+            : _stream(stream)
+        {}
+
+        void WriteCommand(DrawCommand command)
+        {
+            _stream.push_back(static_cast<PiUInt8>(command));
+        }
+
+        void WriteByte(PiUInt8 value)
+        {
+            _stream.push_back(value);
+        }
+
+        void WriteUInt(PiUInt32 value)
+        {
+            while (value >= 0x80)
+            {
+                _stream.push_back(static_cast<PiUInt8>(value | 0x80));
+                value >>= 7;
+            }
+
+            _stream.push_back(static_cast<PiUInt8>(value));
+        }
+
+        void WriteInt(PiInt32 value)
+        {
+            WriteUInt((static_cast<PiUInt32>(value) << 1) ^ static_cast<PiUInt32>(value >> 31));
+        }
+
+        void WriteReal(PiReal32 value)
+        {
+            PiUInt8 bytes[sizeof(PiReal32)];
+            std::memcpy(bytes, &value, sizeof(PiReal32));
+            _stream.insert(_stream.end(), bytes, bytes + sizeof(PiReal32));
+        }
+
+        void WriteString(const PiString& value)
+        {
+            WriteUInt(static_cast<PiUInt32>(value.size()));
+            _stream.insert(_stream.end(), value.begin(), value.end());
+        }
+
+        void WritePoint(const Point& value)
+        {
+            WriteInt(value.x);
+            WriteInt(value.y);
+        }
+
+        void WriteSize(const Size& value)
+        {
+            WriteInt(value.w);
+            WriteInt(value.h);
+        }
+
+        void WriteRect(const Rect& value)
+        {
+            WriteInt(value.x);
+            WriteInt(value.y);
+            WriteInt(value.w);
+            WriteInt(value.h);
+        }
+
+        void WriteColor(const Color& value)
+        {
+            WriteByte(value.r);
+            WriteByte(value.g);
+            WriteByte(value.b);
+            WriteByte(value.a);
+        }
+
+    private:
+        std::vector<PiUInt8>& _stream;
+    };
+
+    /**
+     * @brief Reads draw commands from a binary stream.
+     *
+     * Reading past the end of the stream or malformed data puts the reader
+     * in an error state, after which every read returns zero values.
+     */
+    class DrawCommandReader
+    {
+    public:
+        DrawCommandReader(const PiUInt8* data, std::size_t size)
+            : _data(data)
+            , _size(size)
+            , _position(0)
+            , _error(false)
+        {}
+
+        [[nodiscard]] bool AtEnd() const
+        {
+            return _error || _position >= _size;
+        }
+
+        [[nodiscard]] bool HasError() const
+        {
+            return _error;
+        }
+
+        DrawCommand ReadCommand()
+        {
+            return static_cast<DrawCommand>(ReadByte());
+        }
+
+        PiUInt8 ReadByte()
+        {
+            if (!Require(1))
+                return 0;
+
+            return _data[_position++];
+        }
+
+        PiUInt32 ReadUInt()
+        {
+            PiUInt32 value = 0;
+
+            for (PiUInt32 shift = 0; shift < 35; shift += 7)
+            {
+                const PiUInt8 byte = ReadByte();
+                value |= static_cast<PiUInt32>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return value;
+            }
+
+            _error = true;
+            return 0;
+        }
+
+        PiInt32 ReadInt()
+        {
+            const PiUInt32 value = ReadUInt();
+            return static_cast<PiInt32>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        PiReal32 ReadReal()
+        {
+            PiReal32 value = 0.0f;
+
+            if (Require(sizeof(PiReal32)))
+            {
+                std::memcpy(&value, _data + _position, sizeof(PiReal32));
+                _position += sizeof(PiReal32);
+            }
+
+            return value;
+        }
+
+        PiString ReadString()
+        {
+            const PiUInt32 length = ReadUInt();
+
+            if (!Require(length))
+                return PiString();
+
+            PiString value(reinterpret_cast<const char*>(_data + _position), length);
+            _position += length;
+
+            return value;
+        }
+
+        Point ReadPoint()
+        {
+            const PiInt32 x = ReadInt();
+            const PiInt32 y = ReadInt();
+            return Point(x, y);
+        }
+
+        Size ReadSize()
+        {
+            const PiInt32 w = ReadInt();
+            const PiInt32 h = ReadInt();
+            return Size(w, h);
+        }
+
+        Rect ReadRect()
+        {
+            const PiInt32 x = ReadInt();
+            const PiInt32 y = ReadInt();
+            const PiInt32 w = ReadInt();
+            const PiInt32 h = ReadInt();
+            return Rect(x, y, w, h);
+        }
+
+        Color ReadColor()
+        {
+            const PiUInt8 r = ReadByte();
+            const PiUInt8 g = ReadByte();
+            const PiUInt8 b = ReadByte();
+            const PiUInt8 a = ReadByte();
+            return Color(r, g, b, a);
+        }
+
+        void SetError()
+        {
+            _error = true;
+        }
+
+    private:
+        bool Require(std::size_t count)
+        {
+            if (_error || _size - _position < count)
+            {
+                _error = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        const PiUInt8* _data;
+        std::size_t _size;
+        std::size_t _position;
+        bool _error;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_DRAWCOMMANDSTREAM_H
@@ -0,0 +1,239 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/NullRenderer.h>
+
+#include <cmath>
+
+namespace SparkyStudios::UI::Pixel
+{
+    PiUInt64 Renderer_Null::Counters::GetDrawCount() const
+    {
+        return filledRects + texturedRects + linedRects + pixels + filledEllipses + linedEllipses + filledTriangles + linedTriangles +
+            shavedCornerRects + strings;
+    }
+
+    Renderer_Null::Renderer_Null(ResourcePaths& paths)
+        : BaseRenderer(paths)
+        , _textureSize(32, 32)
+    {}
+
+    const Renderer_Null::Counters& Renderer_Null::GetCounters() const
+    {
+        return _counters;
+    }
+
+    void Renderer_Null::ResetCounters()
+    {
+        _counters = Counters();
+    }
+
+    void Renderer_Null::SetTextureSize(const Size& size)
+    {
+        _textureSize = size;
+
+        for (auto&& texture : _textures)
+        {
+            texture.second.width = size.w;
+            texture.second.height = size.h;
+        }
+    }
+
+    void Renderer_Null::Begin()
+    {
+        BaseRenderer::Begin();
+        _counters.frames++;
+    }
+
+    void Renderer_Null::SetDrawColor(const Color& color)
+    {
+        _counters.setDrawColor++;
+    }
+
+    void Renderer_Null::StartClip()
+    {
+        _counters.startClip++;
+    }
+
+    void Renderer_Null::EndClip()
+    {
+        _counters.endClip++;
+    }
+
+    void Renderer_Null::DrawFilledRect(Rect rect, const Size& radii)
+    {
+        CountDraw(_counters.filledRects);
+    }
+
+    void Renderer_Null::DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2)
+    {
+        EnsureTexture(texture);
+        CountDraw(_counters.texturedRects);
+    }
+
+    void Renderer_Null::DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii)
+    {
+        CountDraw(_counters.linedRects);
+    }
+
+    void Renderer_Null::DrawPixel(const Point& position)
+    {
+        CountDraw(_counters.pixels);
+    }
+
+    void Renderer_Null::DrawFilledEllipse(Rect rect)
+    {
+        CountDraw(_counters.filledEllipses);
+    }
+
+    void Renderer_Null::DrawLinedEllipse(Rect rect, PiUInt32 thickness)
+    {
+        CountDraw(_counters.linedEllipses);
+    }
+
+    void Renderer_Null::DrawFilledTriangle(Point p1, Point p2, Point p3)
+    {
+        CountDraw(_counters.filledTriangles);
+    }
+
+    void Renderer_Null::DrawLinedTriangle(Point p1, Point p2, Point p3, PiUInt32 thickness)
+    {
+        CountDraw(_counters.linedTriangles);
+    }
+
+    void Renderer_Null::DrawShavedCornerRect(Rect rect, bool slight)
+    {
+        CountDraw(_counters.shavedCornerRects);
+    }
+
+    void Renderer_Null::DrawString(const Font& font, Point pos, const PiString& text)
+    {
+        EnsureFont(font);
+        CountDraw(_counters.strings);
+    }
+
+    Size Renderer_Null::MeasureText(const Font& font, const PiString& text)
+    {
+        _counters.measures++;
+
+        if (!EnsureFont(font))
+            return Size(0, 0);
+
+        PiInt32 codepoints = 0;
+        for (const char c : text)
+        {
+            // Count every byte which is not a UTF-8 continuation byte.
+            if ((static_cast<PiUInt8>(c) & 0xC0) != 0x80)
+                codepoints++;
+        }
+
+        const PiReal32 size = font.size;
+
+        return Size(codepoints * static_cast<PiInt32>(std::ceil(size * 0.5f)), static_cast<PiInt32>(std::ceil(size * 1.25f)));
+    }
+
+    bool Renderer_Null::InitializeContext(MainWindow* window)
+    {
+        return true;
+    }
+
+    bool Renderer_Null::DestroyContext(MainWindow* window)
+    {
+        return true;
+    }
+
+    bool Renderer_Null::ResizedContext(MainWindow* window, const Size& size)
+    {
+        return true;
+    }
+
+    bool Renderer_Null::BeginContext(MainWindow* window)
+    {
+        return true;
+    }
+
+    bool Renderer_Null::EndContext(MainWindow* window)
+    {
+        return true;
+    }
+
+    bool Renderer_Null::PresentContext(MainWindow* window)
+    {
+        return true;
+    }
+
+    IResourceLoader::LoadStatus Renderer_Null::LoadFont(const Font& font)
+    {
+        _counters.fontLoads++;
+        _fonts.insert(font);
+
+        return LoadStatus::Loaded;
+    }
+
+    void Renderer_Null::FreeFont(const Font& font)
+    {
+        _fonts.erase(font);
+    }
+
+    IResourceLoader::LoadStatus Renderer_Null::LoadTexture(const Texture& texture)
+    {
+        _counters.textureLoads++;
+
+        TextureData data;
+        data.width = _textureSize.w;
+        data.height = _textureSize.h;
+        data.readable = texture.readable;
+
+        _textures[texture] = data;
+
+        return LoadStatus::Loaded;
+    }
+
+    void Renderer_Null::FreeTexture(const Texture& texture)
+    {
+        _textures.erase(texture);
+    }
+
+    TextureData Renderer_Null::GetTextureData(const Texture& texture) const
+    {
+        auto it = _textures.find(texture);
+        if (it != _textures.end())
+            return it->second;
+
+        return TextureData();
+    }
+
+    bool Renderer_Null::EnsureFont(const Font& font)
+    {
+        if (_fonts.find(font) != _fonts.end())
+            return true;
+
+        return LoadFont(font) == LoadStatus::Loaded;
+    }
+
+    bool Renderer_Null::EnsureTexture(const Texture& texture)
+    {
+        if (_textures.find(texture) != _textures.end())
+            return true;
+
+        return LoadTexture(texture) == LoadStatus::Loaded;
+    }
+
+    void Renderer_Null::CountDraw(PiUInt64& counter)
+    {
+        counter++;
+        m_frameStats.primitives++;
+        m_frameStats.drawCalls++;
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,784 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Log.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/RecordingRenderer.h>
+
+#include <Core/Renderer/DrawCommandStream.h>
+
+#include <fstream>
+
+namespace SparkyStudios::UI::Pixel
+{
+    static constexpr char kRecordingMagic[4] = { 'P', 'I', 'D', 'R' };
+    static constexpr PiUInt8 kRecordingVersion = 1;
+
+    RecordingRenderer::RecordingRenderer(ResourcePaths& paths, BaseRenderer* target)
+        : BaseRenderer(paths)
+        , _target(target)
+        , _recording(true)
+        , _commandCount(0)
+        , _stateRecorded(false)
+        , _recordedScale(1.0f)
+    {}
+
+    void RecordingRenderer::SetTarget(BaseRenderer* target)
+    {
+        _target = target;
+    }
+
+    BaseRenderer* RecordingRenderer::GetTarget() const
+    {
+        return _target;
+    }
+
+    void RecordingRenderer::SetRecording(bool recording)
+    {
+        _recording = recording;
+    }
+
+    bool RecordingRenderer::IsRecording() const
+    {
+        return _recording;
+    }
+
+    const std::vector<PiUInt8>& RecordingRenderer::GetStream() const
+    {
+        return _stream;
+    }
+
+    PiUInt32 RecordingRenderer::GetCommandCount() const
+    {
+        return _commandCount;
+    }
+
+    void RecordingRenderer::Clear()
+    {
+        _stream.clear();
+        _commandCount = 0;
+        _fontIds.clear();
+        _textureIds.clear();
+        _stateRecorded = false;
+    }
+
+    bool RecordingRenderer::SaveToFile(const PiString& path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            Log::Write(Log::Level::Error, "Unable to open the recording file: %s", path.c_str());
+            return false;
+        }
+
+        file.write(kRecordingMagic, sizeof(kRecordingMagic));
+        file.put(static_cast<char>(kRecordingVersion));
+        file.write(reinterpret_cast<const char*>(_stream.data()), static_cast<std::streamsize>(_stream.size()));
+
+        return file.good();
+    }
+
+    void RecordingRenderer::Init()
+    {
+        if (_target != nullptr)
+            _target->Init();
+    }
+
+    void RecordingRenderer::Begin()
+    {
+        BaseRenderer::Begin();
+
+        if (_recording)
+        {
+            // The renderer state is reset by the widgets at the beginning of each frame.
+            _stateRecorded = false;
+            DrawCommandWriter(_stream).WriteCommand(DrawCommand::BeginFrame);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+            _target->Begin();
+    }
+
+    void RecordingRenderer::End()
+    {
+        if (_recording)
+        {
+            DrawCommandWriter(_stream).WriteCommand(DrawCommand::EndFrame);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->End();
+        }
+    }
+
+    void RecordingRenderer::Flush()
+    {
+        if (_target != nullptr)
+            _target->Flush();
+    }
+
+    void RecordingRenderer::SetDrawColor(const Color& color)
+    {
+        if (_recording)
+        {
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::SetDrawColor);
+            writer.WriteColor(color);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+            _target->SetDrawColor(color);
+    }
+
+    void RecordingRenderer::StartClip()
+    {
+        if (_recording)
+        {
+            RecordState();
+            DrawCommandWriter(_stream).WriteCommand(DrawCommand::StartClip);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->StartClip();
+        }
+    }
+
+    void RecordingRenderer::EndClip()
+    {
+        if (_recording)
+        {
+            DrawCommandWriter(_stream).WriteCommand(DrawCommand::EndClip);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+            _target->EndClip();
+    }
+
+    Color RecordingRenderer::PixelColor(const Texture& texture, const Point& position, const Color& defaultColor)
+    {
+        if (_target != nullptr)
+            return _target->PixelColor(texture, position, defaultColor);
+
+        return defaultColor;
+    }
+
+    void RecordingRenderer::DrawFilledRect(Rect rect, const Size& radii)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawFilledRect);
+            writer.WriteRect(rect);
+            writer.WriteSize(radii);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawFilledRect(rect, radii);
+        }
+    }
+
+    void RecordingRenderer::DrawTexturedRect(const Texture& texture, Rect rect, PiReal32 u1, PiReal32 v1, PiReal32 u2, PiReal32 v2)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+            const PiUInt32 id = InternTexture(texture);
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawTexturedRect);
+            writer.WriteUInt(id);
+            writer.WriteRect(rect);
+            writer.WriteReal(u1);
+            writer.WriteReal(v1);
+            writer.WriteReal(u2);
+            writer.WriteReal(v2);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawTexturedRect(texture, rect, u1, v1, u2, v2);
+        }
+    }
+
+    void RecordingRenderer::DrawLinedRect(Rect rect, PiUInt32 thickness, const Size& radii)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawLinedRect);
+            writer.WriteRect(rect);
+            writer.WriteUInt(thickness);
+            writer.WriteSize(radii);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawLinedRect(rect, thickness, radii);
+        }
+    }
+
+    void RecordingRenderer::DrawPixel(const Point& position)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawPixel);
+            writer.WritePoint(position);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawPixel(position);
+        }
+    }
+
+    void RecordingRenderer::DrawFilledEllipse(Rect rect)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawFilledEllipse);
+            writer.WriteRect(rect);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawFilledEllipse(rect);
+        }
+    }
+
+    void RecordingRenderer::DrawLinedEllipse(Rect rect, PiUInt32 thickness)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawLinedEllipse);
+            writer.WriteRect(rect);
+            writer.WriteUInt(thickness);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawLinedEllipse(rect, thickness);
+        }
+    }
+
+    void RecordingRenderer::DrawFilledTriangle(Point p1, Point p2, Point p3)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawFilledTriangle);
+            writer.WritePoint(p1);
+            writer.WritePoint(p2);
+            writer.WritePoint(p3);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawFilledTriangle(p1, p2, p3);
+        }
+    }
+
+    void RecordingRenderer::DrawLinedTriangle(Point p1, Point p2, Point p3, PiUInt32 thickness)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawLinedTriangle);
+            writer.WritePoint(p1);
+            writer.WritePoint(p2);
+            writer.WritePoint(p3);
+            writer.WriteUInt(thickness);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawLinedTriangle(p1, p2, p3, thickness);
+        }
+    }
+
+    void RecordingRenderer::DrawShavedCornerRect(Rect rect, bool slight)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawShavedCornerRect);
+            writer.WriteRect(rect);
+            writer.WriteByte(slight ? 1 : 0);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawShavedCornerRect(rect, slight);
+        }
+    }
+
+    void RecordingRenderer::DrawString(const Font& font, Point pos, const PiString& text)
+    {
+        m_frameStats.primitives++;
+
+        if (_recording)
+        {
+            RecordState();
+            const PiUInt32 id = InternFont(font);
+
+            DrawCommandWriter writer(_stream);
+            writer.WriteCommand(DrawCommand::DrawString);
+            writer.WriteUInt(id);
+            writer.WritePoint(pos);
+            writer.WriteString(text);
+            _commandCount++;
+        }
+
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            _target->DrawString(font, pos, text);
+        }
+    }
+
+    Size RecordingRenderer::MeasureText(const Font& font, const PiString& text)
+    {
+        if (_target != nullptr)
+        {
+            SyncTarget();
+            return _target->MeasureText(font, text);
+        }
+
+        return BaseRenderer::MeasureText(font, text);
+    }
+
+    bool RecordingRenderer::InitializeContext(MainWindow* window)
+    {
+        return _target != nullptr ? _target->InitializeContext(window) : true;
+    }
+
+    bool RecordingRenderer::DestroyContext(MainWindow* window)
+    {
+        return _target != nullptr ? _target->DestroyContext(window) : true;
+    }
+
+    bool RecordingRenderer::ResizedContext(MainWindow* window, const Size& size)
+    {
+        return _target != nullptr ? _target->ResizedContext(window, size) : true;
+    }
+
+    bool RecordingRenderer::BeginContext(MainWindow* window)
+    {
+        return _target != nullptr ? _target->BeginContext(window) : true;
+    }
+
+    bool RecordingRenderer::EndContext(MainWindow* window)
+    {
+        return _target != nullptr ? _target->EndContext(window) : true;
+    }
+
+    bool RecordingRenderer::PresentContext(MainWindow* window)
+    {
+        return _target != nullptr ? _target->PresentContext(window) : true;
+    }
+
+    IResourceLoader::LoadStatus RecordingRenderer::LoadFont(const Font& font)
+    {
+        return _target != nullptr ? _target->LoadFont(font) : LoadStatus::Loaded;
+    }
+
+    void RecordingRenderer::FreeFont(const Font& font)
+    {
+        if (_target != nullptr)
+            _target->FreeFont(font);
+    }
+
+    IResourceLoader::LoadStatus RecordingRenderer::LoadTexture(const Texture& texture)
+    {
+        return _target != nullptr ? _target->LoadTexture(texture) : LoadStatus::Loaded;
+    }
+
+    IResourceLoader::LoadStatus RecordingRenderer::LoadTextureAsync(const Texture& texture)
+    {
+        return _target != nullptr ? _target->LoadTextureAsync(texture) : LoadStatus::Loaded;
+    }
+
+    IResourceLoader::LoadStatus RecordingRenderer::GetTextureStatus(const Texture& texture) const
+    {
+        return _target != nullptr ? _target->GetTextureStatus(texture) : LoadStatus::Loaded;
+    }
+
+    void RecordingRenderer::FreeTexture(const Texture& texture)
+    {
+        if (_target != nullptr)
+            _target->FreeTexture(texture);
+    }
+
+    IResourceLoader::LoadStatus RecordingRenderer::AcquireTexture(const Texture& texture, bool async)
+    {
+        return _target != nullptr ? _target->AcquireTexture(texture, async) : LoadStatus::Loaded;
+    }
+
+    void RecordingRenderer::ReleaseTexture(const Texture& texture)
+    {
+        if (_target != nullptr)
+            _target->ReleaseTexture(texture);
+    }
+
+    TextureData RecordingRenderer::GetTextureData(const Texture& texture) const
+    {
+        return _target != nullptr ? _target->GetTextureData(texture) : TextureData();
+    }
+
+    void RecordingRenderer::RecordState()
+    {
+        DrawCommandWriter writer(_stream);
+
+        const Point& offset = GetRenderOffset();
+        if (!_stateRecorded || offset.x != _recordedOffset.x || offset.y != _recordedOffset.y)
+        {
+            writer.WriteCommand(DrawCommand::SetRenderOffset);
+            writer.WritePoint(offset);
+            _recordedOffset = offset;
+            _commandCount++;
+        }
+
+        const Rect& clip = ClipRegion();
+        if (!_stateRecorded || clip.x != _recordedClip.x || clip.y != _recordedClip.y || clip.w != _recordedClip.w ||
+            clip.h != _recordedClip.h)
+        {
+            writer.WriteCommand(DrawCommand::SetClipRegion);
+            writer.WriteRect(clip);
+            _recordedClip = clip;
+            _commandCount++;
+        }
+
+        if (!_stateRecorded || GetScale() != _recordedScale)
+        {
+            writer.WriteCommand(DrawCommand::SetScale);
+            writer.WriteReal(GetScale());
+            _recordedScale = GetScale();
+            _commandCount++;
+        }
+
+        _stateRecorded = true;
+    }
+
+    void RecordingRenderer::SyncTarget()
+    {
+        _target->SetRenderOffset(GetRenderOffset());
+        _target->SetClipRegion(ClipRegion());
+        _target->SetScale(GetScale());
+    }
+
+    PiUInt32 RecordingRenderer::InternFont(const Font& font)
+    {
+        auto it = _fontIds.find(font);
+        if (it != _fontIds.end())
+            return it->second;
+
+        const auto id = static_cast<PiUInt32>(_fontIds.size());
+        _fontIds.emplace(font, id);
+
+        DrawCommandWriter writer(_stream);
+        writer.WriteCommand(DrawCommand::DefineFont);
+        writer.WriteString(font.facename);
+        writer.WriteReal(font.size);
+        writer.WriteByte(static_cast<PiUInt8>(font.weight));
+        writer.WriteByte(static_cast<PiUInt8>(font.style));
+        _commandCount++;
+
+        return id;
+    }
+
+    PiUInt32 RecordingRenderer::InternTexture(const Texture& texture)
+    {
+        auto it = _textureIds.find(texture);
+        if (it != _textureIds.end())
+            return it->second;
+
+        const auto id = static_cast<PiUInt32>(_textureIds.size());
+        _textureIds.emplace(texture, id);
+
+        DrawCommandWriter writer(_stream);
+        writer.WriteCommand(DrawCommand::DefineTexture);
+        writer.WriteString(texture.name);
+        writer.WriteByte(texture.readable ? 1 : 0);
+        _commandCount++;
+
+        return id;
+    }
+
+    RecordingPlayer::RecordingPlayer(BaseRenderer* target)
+        : _target(target)
+    {}
+
+    bool RecordingPlayer::Play(const std::vector<PiUInt8>& stream)
+    {
+        return Play(stream.data(), stream.size());
+    }
+
+    bool RecordingPlayer::Play(const PiUInt8* data, std::size_t size)
+    {
+        _fonts.clear();
+        _textures.clear();
+
+        DrawCommandReader reader(data, size);
+
+        while (!reader.AtEnd())
+        {
+            switch (reader.ReadCommand())
+            {
+            case DrawCommand::BeginFrame:
+                _target->Begin();
+                break;
+
+            case DrawCommand::EndFrame:
+                _target->End();
+                break;
+
+            case DrawCommand::SetRenderOffset:
+                _target->SetRenderOffset(reader.ReadPoint());
+                break;
+
+            case DrawCommand::SetClipRegion:
+                _target->SetClipRegion(reader.ReadRect());
+                break;
+
+            case DrawCommand::SetScale:
+                _target->SetScale(reader.ReadReal());
+                break;
+
+            case DrawCommand::SetDrawColor:
+                _target->SetDrawColor(reader.ReadColor());
+                break;
+
+            case DrawCommand::StartClip:
+                _target->StartClip();
+                break;
+
+            case DrawCommand::EndClip:
+                _target->EndClip();
+                break;
+
+            case DrawCommand::DefineFont:
+                {
+                    Font font;
+                    font.facename = reader.ReadString();
+                    font.size = reader.ReadReal();
+                    font.weight = static_cast<Font::Weight>(reader.ReadByte());
+                    font.style = static_cast<Font::Style>(reader.ReadByte());
+                    _fonts.push_back(font);
+                    break;
+                }
+
+            case DrawCommand::DefineTexture:
+                {
+                    Texture texture;
+                    texture.name = reader.ReadString();
+                    texture.readable = reader.ReadByte() != 0;
+                    _textures.push_back(texture);
+                    break;
+                }
+
+            case DrawCommand::DrawFilledRect:
+                {
+                    const Rect rect = reader.ReadRect();
+                    const Size radii = reader.ReadSize();
+                    _target->DrawFilledRect(rect, radii);
+                    break;
+                }
+
+            case DrawCommand::DrawTexturedRect:
+                {
+                    const PiUInt32 id = reader.ReadUInt();
+                    const Rect rect = reader.ReadRect();
+                    const PiReal32 u1 = reader.ReadReal();
+                    const PiReal32 v1 = reader.ReadReal();
+                    const PiReal32 u2 = reader.ReadReal();
+                    const PiReal32 v2 = reader.ReadReal();
+
+                    if (id >= _textures.size())
+                    {
+                        reader.SetError();
+                        break;
+                    }
+
+                    _target->DrawTexturedRect(_textures[id], rect, u1, v1, u2, v2);
+                    break;
+                }
+
+            case DrawCommand::DrawLinedRect:
+                {
+                    const Rect rect = reader.ReadRect();
+                    const PiUInt32 thickness = reader.ReadUInt();
+                    const Size radii = reader.ReadSize();
+                    _target->DrawLinedRect(rect, thickness, radii);
+                    break;
+                }
+
+            case DrawCommand::DrawPixel:
+                _target->DrawPixel(reader.ReadPoint());
+                break;
+
+            case DrawCommand::DrawFilledEllipse:
+                _target->DrawFilledEllipse(reader.ReadRect());
+                break;
+
+            case DrawCommand::DrawLinedEllipse:
+                {
+                    const Rect rect = reader.ReadRect();
+                    const PiUInt32 thickness = reader.ReadUInt();
+                    _target->DrawLinedEllipse(rect, thickness);
+                    break;
+                }
+
+            case DrawCommand::DrawFilledTriangle:
+                {
+                    const Point p1 = reader.ReadPoint();
+                    const Point p2 = reader.ReadPoint();
+                    const Point p3 = reader.ReadPoint();
+                    _target->DrawFilledTriangle(p1, p2, p3);
+                    break;
+                }
+
+            case DrawCommand::DrawLinedTriangle:
+                {
+                    const Point p1 = reader.ReadPoint();
+                    const Point p2 = reader.ReadPoint();
+                    const Point p3 = reader.ReadPoint();
+                    const PiUInt32 thickness = reader.ReadUInt();
+                    _target->DrawLinedTriangle(p1, p2, p3, thickness);
+                    break;
+                }
+
+            case DrawCommand::DrawShavedCornerRect:
+                {
+                    const Rect rect = reader.ReadRect();
+                    const bool slight = reader.ReadByte() != 0;
+                    _target->DrawShavedCornerRect(rect, slight);
+                    break;
+                }
+
+            case DrawCommand::DrawString:
+                {
+                    const PiUInt32 id = reader.ReadUInt();
+                    const Point pos = reader.ReadPoint();
+                    const PiString text = reader.ReadString();
+
+                    if (id >= _fonts.size())
+                    {
+                        reader.SetError();
+                        break;
+                    }
+
+                    _target->DrawString(_fonts[id], pos, text);
+                    break;
+                }
+
+            default:
+                reader.SetError();
+                break;
+            }
+        }
+
+        if (reader.HasError())
+        {
+            Log::Write(Log::Level::Error, "Malformed draw command stream, the replay has been stopped.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RecordingPlayer::LoadFromFile(const PiString& path, std::vector<PiUInt8>& stream)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            Log::Write(Log::Level::Error, "Recording file not found: %s", path.c_str());
+            return false;
+        }
+
+        char magic[sizeof(kRecordingMagic)];
+        file.read(magic, sizeof(magic));
+
+        if (!file || std::memcmp(magic, kRecordingMagic, sizeof(kRecordingMagic)) != 0 || file.get() != kRecordingVersion)
+        {
+            Log::Write(Log::Level::Error, "Invalid recording file: %s", path.c_str());
+            return false;
+        }
+
+        stream.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,177 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_RESOURCETABLE_H
+#define PIXEL_UI_RESOURCETABLE_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief Stores loaded resources, and interns a small integer handle for each of them.
+     *
+     * The handle is written back in the mutable handle field of the keys used to look up
+     * a resource, so looking it up again with the same key is an array index instead of
+     * a hash of its name. Keys must expose a mutable PiHandle named handle, which isn't
+     * part of their identity.
+     *
+     * A handle packs the index of a slot with the generation of that slot, which is bumped
+     * when its resource is erased, so handle 0 is never valid. The key of the slot is still
+     * compared, since the key may have been changed or used with another table since its
+     * handle was cached, and the lookup then falls back to the hash map.
+     */
+    template<typename Key, typename Value, typename Hash = std::hash<Key>>
+    class ResourceTable
+    {
+    public:
+        typedef std::pair<const Key, Value> Entry;
+
+        ResourceTable()
+            : _slots(1)
+        {}
+
+        ResourceTable(const ResourceTable&) = delete;
+        ResourceTable& operator=(const ResourceTable&) = delete;
+
+        /**
+         * @brief Finds a resource, and caches its handle in the given key.
+         *
+         * @return The resource, or nullptr if it isn't in the table.
+         */
+        Entry* Find(const Key& key) const
+        {
+            if (Entry* entry = Get(key.handle); entry != nullptr && entry->first == key)
+                return entry;
+
+            auto it = _entries.find(key);
+            if (it == _entries.end())
+                return nullptr;
+
+            key.handle = it->first.handle;
+            return _slots[key.handle & kIndexMask].entry;
+        }
+
+        /**
+         * @brief Gets the resource with the given handle.
+         *
+         * @return The resource, or nullptr if the handle is invalid or has been released.
+         */
+        Entry* Get(PiHandle handle) const
+        {
+            const PiHandle index = handle & kIndexMask;
+            if (index >= _slots.size())
+                return nullptr;
+
+            const Slot& slot = _slots[index];
+            return slot.generation == handle >> kIndexBits ? slot.entry : nullptr;
+        }
+
+        /**
+         * @brief Adds a resource, which must not be in the table yet, and caches its handle in the given key.
+         */
+        Entry* Insert(const Key& key, Value&& value)
+        {
+            Entry* entry = &*_entries.emplace(key, std::move(value)).first;
+
+            PiHandle index;
+            if (_free.empty())
+            {
+                index = static_cast<PiHandle>(_slots.size());
+                _slots.emplace_back();
+            }
+            else
+            {
+                index = _free.back();
+                _free.pop_back();
+            }
+
+            Slot& slot = _slots[index];
+            slot.entry = entry;
+
+            const PiHandle handle = slot.generation << kIndexBits | index;
+            entry->first.handle = handle;
+            key.handle = handle;
+
+            return entry;
+        }
+
+        /**
+         * @brief Removes a resource and releases its handle.
+         *
+         * @return Whether the resource was in the table.
+         */
+        bool Erase(const Key& key)
+        {
+            auto it = _entries.find(key);
+            if (it == _entries.end())
+                return false;
+
+            const PiHandle index = it->first.handle & kIndexMask;
+            _entries.erase(it);
+
+            // Invalidates the handles still held by other keys.
+            Slot& slot = _slots[index];
+            slot.entry = nullptr;
+            slot.generation = (slot.generation + 1) & kGenerationMask;
+            _free.push_back(index);
+
+            return true;
+        }
+
+        bool Contains(const Key& key) const
+        {
+            return Find(key) != nullptr;
+        }
+
+        std::size_t Size() const
+        {
+            return _entries.size();
+        }
+
+        /**
+         * @brief Calls the given function with every resource. The table must not be modified meanwhile.
+         */
+        template<typename Function>
+        void ForEach(Function&& function) const
+        {
+            for (auto&& entry : _entries)
+                function(entry);
+        }
+
+    private:
+        static constexpr PiHandle kIndexBits = 20;
+        static constexpr PiHandle kIndexMask = (1u << kIndexBits) - 1;
+        static constexpr PiHandle kGenerationMask = (1u << (32 - kIndexBits)) - 1;
+
+        struct Slot
+        {
+            Entry* entry = nullptr;
+            PiHandle generation = 0;
+        };
+
+        // Map nodes never move, so the slots can point into them. Slot 0 is never used, so handle 0 is invalid.
+        std::unordered_map<Key, Value, Hash> _entries;
+        std::vector<Slot> _slots;
+        std::vector<PiHandle> _free;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_RESOURCETABLE_H
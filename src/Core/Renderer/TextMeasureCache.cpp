@@ -0,0 +1,131 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Common.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/TextMeasureCache.h>
+
+#include <functional>
+
+namespace SparkyStudios::UI::Pixel
+{
+    std::size_t TextMeasureCache::KeyHasher::operator()(const Key& key) const
+    {
+        std::size_t hash = std::hash<FontHandle>{}(key.font);
+        HashCombine(hash, key.hash);
+        return hash;
+    }
+
+    TextMeasureCache::TextMeasureCache(std::size_t capacity)
+        : _capacity(capacity)
+    {}
+
+    bool TextMeasureCache::Find(FontHandle font, const PiString& text, Size& size)
+    {
+        const auto it = _index.find({ font, std::hash<PiString>{}(text) });
+
+        if (it == _index.end() || it->second->text != text)
+        {
+            _stats.misses++;
+            return false;
+        }
+
+        // Move the entry to the front, as the most recently used one.
+        _entries.splice(_entries.begin(), _entries, it->second);
+
+        _stats.hits++;
+        size = it->second->size;
+        return true;
+    }
+
+    void TextMeasureCache::Insert(FontHandle font, const PiString& text, const Size& size)
+    {
+        if (_capacity == 0)
+            return;
+
+        const Key key = { font, std::hash<PiString>{}(text) };
+
+        const auto it = _index.find(key);
+        if (it != _index.end())
+        {
+            // Either the same text, or a hash collision. In both cases the new measurement wins.
+            it->second->text = text;
+            it->second->size = size;
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return;
+        }
+
+        _entries.push_front({ key, text, size });
+        _index.emplace(key, _entries.begin());
+
+        Trim();
+    }
+
+    void TextMeasureCache::Invalidate(FontHandle font)
+    {
+        for (auto it = _entries.begin(); it != _entries.end();)
+        {
+            if (it->key.font == font)
+            {
+                _index.erase(it->key);
+                it = _entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void TextMeasureCache::Clear()
+    {
+        _index.clear();
+        _entries.clear();
+    }
+
+    void TextMeasureCache::SetCapacity(std::size_t capacity)
+    {
+        _capacity = capacity;
+        Trim();
+    }
+
+    std::size_t TextMeasureCache::GetCapacity() const
+    {
+        return _capacity;
+    }
+
+    std::size_t TextMeasureCache::GetSize() const
+    {
+        return _entries.size();
+    }
+
+    const TextMeasureCache::Stats& TextMeasureCache::GetStats() const
+    {
+        return _stats;
+    }
+
+    void TextMeasureCache::ResetStats()
+    {
+        _stats = Stats();
+    }
+
+    void TextMeasureCache::Trim()
+    {
+        while (_entries.size() > _capacity)
+        {
+            _index.erase(_entries.back().key);
+            _entries.pop_back();
+            _stats.evictions++;
+        }
+    }
+} // namespace SparkyStudios::UI::Pixel
@@ -0,0 +1,234 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/UI/Pixel/Core/Log.h>
+#include <SparkyStudios/UI/Pixel/Core/ResourcePack.h>
+
+#include <Core/MappedFile.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace SparkyStudios::UI::Pixel
+{
+    static constexpr char kPackMagic[4] = { 'P', 'I', 'P', 'K' };
+
+    // The size of the pack header, and of an index entry without its name.
+    static constexpr PiUInt64 kHeaderSize = 16;
+    static constexpr PiUInt64 kEntrySize = 24;
+
+    static PiUInt64 ReadUInt(const PiUInt8* data, PiUInt32 bytes)
+    {
+        PiUInt64 value = 0;
+
+        for (PiUInt32 i = 0; i < bytes; ++i)
+            value |= static_cast<PiUInt64>(data[i]) << (i * 8);
+
+        return value;
+    }
+
+    static void WriteUInt(std::ofstream& stream, PiUInt64 value, PiUInt32 bytes)
+    {
+        for (PiUInt32 i = 0; i < bytes; ++i)
+            stream.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    static PiString GetResourceName(ResourcePaths::Type type, const PiString& name)
+    {
+        // Only support TTF files for fonts
+        if (type == ResourcePaths::Type::Font && name.find(".ttf") == PiString::npos)
+            return name + ".ttf";
+
+        return name;
+    }
+
+    bool ResourcePack::Write(const PiString& path, const std::vector<Source>& sources)
+    {
+        std::vector<PiUInt64> sizes;
+        sizes.reserve(sources.size());
+
+        PiUInt64 offset = kHeaderSize;
+
+        for (auto&& source : sources)
+        {
+            std::ifstream file(source.path, std::ios::binary | std::ios::ate);
+
+            if (!file)
+            {
+                Log::Write(Log::Level::Error, "Resource file not found: %s", source.path.c_str());
+                return false;
+            }
+
+            sizes.push_back(static_cast<PiUInt64>(file.tellg()));
+            offset += kEntrySize + source.name.size();
+        }
+
+        std::ofstream pack(path, std::ios::binary | std::ios::trunc);
+
+        if (!pack)
+        {
+            Log::Write(Log::Level::Error, "Unable to write the resource pack: %s", path.c_str());
+            return false;
+        }
+
+        pack.write(kPackMagic, sizeof(kPackMagic));
+        WriteUInt(pack, kVersion, 4);
+        WriteUInt(pack, sources.size(), 4);
+        WriteUInt(pack, 0, 4);
+
+        for (std::size_t i = 0, l = sources.size(); i < l; ++i)
+        {
+            WriteUInt(pack, static_cast<PiUInt32>(sources[i].type), 4);
+            WriteUInt(pack, sources[i].name.size(), 4);
+            WriteUInt(pack, offset, 8);
+            WriteUInt(pack, sizes[i], 8);
+            pack.write(sources[i].name.data(), static_cast<std::streamsize>(sources[i].name.size()));
+
+            offset += sizes[i];
+        }
+
+        for (auto&& source : sources)
+        {
+            std::ifstream file(source.path, std::ios::binary);
+            pack << file.rdbuf();
+        }
+
+        return static_cast<bool>(pack);
+    }
+
+    ResourcePack::ResourcePack()
+        : _file(new MappedFile())
+        , _count(0)
+    {}
+
+    ResourcePack::~ResourcePack()
+    {
+        delete _file;
+    }
+
+    bool ResourcePack::Open(const PiString& path)
+    {
+        Close();
+
+        if (!_file->Open(path))
+        {
+            Log::Write(Log::Level::Error, "Resource pack not found: %s", path.c_str());
+            return false;
+        }
+
+        const PiUInt8* data = _file->GetData();
+        const PiUInt64 size = _file->GetSize();
+
+        if (size < kHeaderSize || std::memcmp(data, kPackMagic, sizeof(kPackMagic)) != 0 || ReadUInt(data + 4, 4) != kVersion)
+        {
+            Log::Write(Log::Level::Error, "Invalid resource pack: %s", path.c_str());
+            Close();
+            return false;
+        }
+
+        const PiUInt32 count = static_cast<PiUInt32>(ReadUInt(data + 8, 4));
+        PiUInt64 position = kHeaderSize;
+
+        for (PiUInt32 i = 0; i < count; ++i)
+        {
+            if (position + kEntrySize > size)
+                break;
+
+            const PiUInt64 type = ReadUInt(data + position, 4);
+            const PiUInt64 nameLength = ReadUInt(data + position + 4, 4);
+            const Range range = { ReadUInt(data + position + 8, 8), ReadUInt(data + position + 16, 8) };
+            position += kEntrySize;
+
+            if (type >= static_cast<PiUInt64>(ResourcePaths::Type::MAX) || position + nameLength > size || range.offset > size ||
+                range.size > size - range.offset)
+                break;
+
+            _index[type][PiString(reinterpret_cast<const char*>(data + position), nameLength)] = range;
+            position += nameLength;
+            _count++;
+        }
+
+        if (_count != count)
+        {
+            Log::Write(Log::Level::Error, "Corrupted resource pack: %s", path.c_str());
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void ResourcePack::Close()
+    {
+        for (auto&& index : _index)
+            index.clear();
+
+        _count = 0;
+        _file->Close();
+    }
+
+    bool ResourcePack::IsOpen() const
+    {
+        return _file->IsOpen();
+    }
+
+    PiUInt32 ResourcePack::GetResourceCount() const
+    {
+        return _count;
+    }
+
+    bool ResourcePack::Find(ResourcePaths::Type type, const PiString& name, const void*& data, PiUInt64& size) const
+    {
+        if (type >= ResourcePaths::Type::MAX)
+            return false;
+
+        const auto& index = _index[static_cast<std::size_t>(type)];
+        const auto it = index.find(GetResourceName(type, name));
+
+        if (it == index.end())
+            return false;
+
+        data = _file->GetData() + it->second.offset;
+        size = it->second.size;
+
+        return true;
+    }
+
+    ResourcePackPaths::ResourcePackPaths(const PiString& packPath, const ResourcePaths* fallback)
+        : _fallback(fallback)
+    {
+        _pack.Open(packPath);
+    }
+
+    PiString ResourcePackPaths::GetPath(Type type, const PiString& name) const
+    {
+        if (_fallback != nullptr)
+            return _fallback->GetPath(type, name);
+
+        return GetResourceName(type, name);
+    }
+
+    bool ResourcePackPaths::GetData(Type type, const PiString& name, const void*& data, PiUInt64& size) const
+    {
+        if (_pack.Find(type, name, data, size))
+            return true;
+
+        return _fallback != nullptr && _fallback->GetData(type, name, data, size);
+    }
+
+    const ResourcePack& ResourcePackPaths::GetPack() const
+    {
+        return _pack;
+    }
+} // namespace SparkyStudios::UI::Pixel
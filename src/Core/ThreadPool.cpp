@@ -0,0 +1,93 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/ThreadPool.h>
+
+namespace SparkyStudios::UI::Pixel
+{
+    ThreadPool::ThreadPool(PiUInt32 threadCount)
+        : _pending(0)
+        , _stopping(false)
+    {
+        _threads.reserve(threadCount);
+
+        for (PiUInt32 i = 0; i < threadCount; i++)
+            _threads.emplace_back(&ThreadPool::Work, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        Wait();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+
+        _taskAvailable.notify_all();
+
+        for (auto&& thread : _threads)
+            thread.join();
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push(std::move(task));
+            _pending++;
+        }
+
+        _taskAvailable.notify_one();
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _tasksDone.wait(lock, [this] { return _pending == 0; });
+    }
+
+    PiUInt32 ThreadPool::GetThreadCount() const
+    {
+        return static_cast<PiUInt32>(_threads.size());
+    }
+
+    void ThreadPool::Work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _taskAvailable.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+
+                if (_tasks.empty())
+                    return;
+
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pending--;
+            }
+
+            _tasksDone.notify_all();
+        }
+    }
+} // namespace SparkyStudios::UI::Pixel
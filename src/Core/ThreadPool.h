@@ -0,0 +1,80 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef PIXEL_UI_THREADPOOL_H
+#define PIXEL_UI_THREADPOOL_H
+
+#include <SparkyStudios/UI/Pixel/Config/Types.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace SparkyStudios::UI::Pixel
+{
+    /**
+     * @brief A fixed set of worker threads executing queued tasks.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param threadCount The number of worker threads.
+         */
+        explicit ThreadPool(PiUInt32 threadCount);
+
+        /**
+         * @brief Waits for the queued tasks, then stops the worker threads.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queues a task to be executed by a worker thread.
+         */
+        void Enqueue(std::function<void()> task);
+
+        /**
+         * @brief Blocks until every queued task has been executed.
+         */
+        void Wait();
+
+        /**
+         * @brief Gets the number of worker threads.
+         */
+        [[nodiscard]] PiUInt32 GetThreadCount() const;
+
+    private:
+        void Work();
+
+        std::vector<std::thread> _threads;
+        std::queue<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _taskAvailable;
+        std::condition_variable _tasksDone;
+        PiUInt32 _pending;
+        bool _stopping;
+    };
+} // namespace SparkyStudios::UI::Pixel
+
+#endif // PIXEL_UI_THREADPOOL_H
@@ -12,12 +12,51 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <limits>
+
 #include <SparkyStudios/UI/Pixel/Core/MainWindow.h>
 #include <SparkyStudios/UI/Pixel/Core/Platform.h>
+#include <SparkyStudios/UI/Pixel/Core/Renderer/DisplayList.h>
 #include <SparkyStudios/UI/Pixel/Widgets/Canvas.h>
 
+#include <Core/ThreadPool.h>
+
 namespace SparkyStudios::UI::Pixel
 {
+    const PiString Canvas::CachePolicyEvent = "Canvas::Events::CachePolicy";
+
+    struct Canvas::RenderJob
+    {
+        // The recorder never loads resources itself, the paths are only needed to construct it.
+        RenderJob(BaseRenderer* renderer, std::mutex* mutex)
+            : target(renderer)
+            , recorder(const_cast<ResourcePaths&>(renderer->GetResourcePaths()), renderer)
+            , skin(Skin::Data::Default, &recorder)
+        {
+            recorder.SetTargetMutex(mutex);
+        }
+
+        ~RenderJob()
+        {
+            // The skin would release its default font from the renderer otherwise.
+            skin.SetRenderer(nullptr);
+        }
+
+        BaseRenderer* target;
+        DisplayListRecorder recorder;
+        Skin skin;
+        DisplayList list;
+        Widget* widget = nullptr;
+        bool parallel = false;
+
+        // The widgets redrawn while recording, redrawn again on the main thread.
+        std::vector<Widget*> redraws;
+
+        // The canvas skin copied into skin, refreshed only when the canvas skin changes.
+        const Skin* skinSource = nullptr;
+        PiUInt32 skinVersion = 0;
+    };
+
     struct Action
     {
         PiUInt8 type;
@@ -153,6 +192,22 @@ namespace SparkyStudios::UI::Pixel
         }
     }
 
+    PiTime Canvas::Input::GetNextKeyRepeatTime()
+    {
+        PiTime next = std::numeric_limits<PiTime>::infinity();
+
+        if (gKeyboardFocusedWidget == nullptr)
+            return next;
+
+        for (PiUInt32 i = 0; i < (PiUInt32)Key::MAX; i++)
+        {
+            if (gKeyData.KeyState[i] && gKeyData.NextRepeat[i] < next)
+                next = gKeyData.NextRepeat[i];
+        }
+
+        return next;
+    }
+
     bool Canvas::Input::IsKeyDown(Key key)
     {
         return gKeyData.KeyState[(PiUInt32)key];
@@ -456,9 +511,13 @@ namespace SparkyStudios::UI::Pixel
     {}
 
     Canvas::Canvas(MainWindow* window, Skin* skin)
+        : Canvas(Size(window->GetWidth(), window->GetHeight()), skin)
+    {}
+
+    Canvas::Canvas(const Size& size, Skin* skin)
         : ParentClass(nullptr)
     {
-        SetBounds(Rect(0, 0, window->GetWidth(), window->GetHeight()));
+        SetBounds(Rect(0, 0, size.w, size.h));
         SetScale(1.0f);
         SetBackgroundColor(Colors::White);
         SetDrawBackground(true);
@@ -470,36 +529,309 @@ namespace SparkyStudios::UI::Pixel
     Canvas::~Canvas()
     {
         ReleaseChildren();
+        SetRenderWorkerCount(0);
     }
 
-    void Canvas::RenderCanvas()
+    void Canvas::PrepareRender()
     {
         DoThink();
+        RecurseLayout(m_skin);
+
+        // Tooltips follow the mouse and are drawn over everything else, so they always need a full frame.
+        if (!m_dirtyRectsEnabled || IsTooltipActive())
+            m_dirtyRect = RenderBounds();
+
+        m_renderedRect = m_dirtyRect.Intersect(RenderBounds());
+        m_dirtyRect = Rect();
+        m_renderPrepared = true;
+    }
+
+    void Canvas::RenderCanvas()
+    {
+        if (!m_renderPrepared)
+            PrepareRender();
+
+        m_renderPrepared = false;
+
+        if (m_renderedRect.IsEmpty())
+        {
+            m_needsRedraw = false;
+            return;
+        }
+
         BaseRenderer* renderer = m_skin->GetRenderer();
 
         renderer->Begin();
         {
-            RecurseLayout(m_skin);
-            renderer->SetClipRegion(GetBounds());
+            renderer->SetClipRegion(m_renderedRect);
             renderer->SetRenderOffset(Point(0, 0));
             renderer->SetScale(GetScale());
 
-            if (m_drawBackground)
+            renderer->StartClip();
             {
-                renderer->SetDrawColor(m_backgroundColor);
-                renderer->DrawFilledRect(RenderBounds(), Size(0, 0));
-            }
+                if (m_drawBackground)
+                {
+                    renderer->SetDrawColor(m_backgroundColor);
+                    renderer->DrawFilledRect(RenderBounds(), Size(0, 0));
+                }
+
+                m_needsRedraw = false;
 
-            DoRender(m_skin);
-            RenderDragAndDropOverlay(this, m_skin);
-            RenderTooltip(m_skin);
+                DoRender(m_skin);
+                RenderDragAndDropOverlay(this, m_skin);
+                RenderTooltip(m_skin);
+            }
+            renderer->EndClip();
         }
         renderer->End();
+
+        if (m_cachePolicy != nullptr && ++m_cachePolicyFrames >= m_cachePolicy->GetEvaluationInterval())
+        {
+            m_cachePolicyFrames = 0;
+            ApplyCachePolicy(this, false);
+        }
+    }
+
+    void Canvas::SetCachePolicy(ICachePolicy* policy)
+    {
+        m_cachePolicy = policy;
+        m_cachePolicyFrames = 0;
+    }
+
+    void Canvas::SetRenderWorkerCount(PiUInt32 count)
+    {
+        delete m_renderWorkers;
+        m_renderWorkers = count > 0 ? new ThreadPool(count) : nullptr;
+
+        for (auto&& job : m_renderJobs)
+            delete job;
+
+        m_renderJobs.clear();
+    }
+
+    PiUInt32 Canvas::GetRenderWorkerCount() const
+    {
+        return m_renderWorkers != nullptr ? m_renderWorkers->GetThreadCount() : 0;
+    }
+
+    void Canvas::RenderChildren(Skin* skin)
+    {
+        if (m_renderWorkers == nullptr)
+        {
+            ParentClass::RenderChildren(skin);
+            return;
+        }
+
+        BaseRenderer* renderer = skin->GetRenderer();
+        std::size_t jobCount = 0;
+        std::size_t parallelCount = 0;
+        PiUInt32 culledCount = 0;
+
+        std::vector<bool> occluded;
+        FindOccludedChildren(occluded);
+
+        std::size_t index = 0;
+        for (auto it = m_children.cbegin(); it != m_children.cend(); ++it, ++index)
+        {
+            Widget* child = *it;
+
+            if (child->m_hidden)
+                continue;
+
+            if (!occluded.empty() && occluded[index])
+            {
+                child->ThinkRecursive();
+                culledCount++;
+                continue;
+            }
+
+            if (jobCount == m_renderJobs.size())
+                m_renderJobs.push_back(new RenderJob(renderer, &m_renderMutex));
+            else if (m_renderJobs[jobCount]->target != renderer)
+            {
+                delete m_renderJobs[jobCount];
+                m_renderJobs[jobCount] = new RenderJob(renderer, &m_renderMutex);
+            }
+
+            RenderJob* job = m_renderJobs[jobCount++];
+            job->widget = child;
+            job->parallel = CanRenderInParallel(child);
+
+            if (job->parallel)
+                parallelCount++;
+        }
+
+        // A single widget is faster to render directly.
+        if (parallelCount < 2)
+        {
+            ParentClass::RenderChildren(skin);
+            return;
+        }
+
+        for (std::size_t i = 0; i < jobCount; i++)
+        {
+            RenderJob* job = m_renderJobs[i];
+
+            if (!job->parallel)
+                continue;
+
+            job->list.Clear();
+
+            if (job->skinSource != skin || job->skinVersion != m_renderSkinVersion)
+            {
+                job->skin.SetSkinData(skin->GetSkinData());
+                job->skin.SetDefaultFont(skin->GetDefaultFont());
+                job->skinSource = skin;
+                job->skinVersion = m_renderSkinVersion;
+            }
+
+            // Start from the renderer state, so clipped out widgets are skipped by the workers too.
+            job->recorder.Begin();
+            job->recorder.SetScale(renderer->GetScale());
+            job->recorder.SetRenderOffset(renderer->GetRenderOffset());
+            job->recorder.SetClipRegion(renderer->ClipRegion());
+            job->recorder.SetDisplayListsEnabled(renderer->IsDisplayListsEnabled());
+            job->recorder.SetDisplayList(&job->list);
+
+            // Workers only record draw commands, thinking touches input and animation state.
+            job->widget->ThinkRecursive();
+
+            m_renderWorkers->Enqueue(
+                [job]
+                {
+                    Widget::SetRecordingThread(&job->redraws);
+                    job->widget->DoRender(&job->skin);
+                    Widget::SetRecordingThread(nullptr);
+                });
+        }
+
+        m_renderWorkers->Wait();
+        renderer->AddCulledWidgets(culledCount);
+
+        // Redraws walk up to the shared parents, apply them once the workers are done.
+        for (std::size_t i = 0; i < jobCount; i++)
+        {
+            RenderJob* job = m_renderJobs[i];
+
+            for (Widget* widget : job->redraws)
+                widget->Redraw();
+
+            job->redraws.clear();
+        }
+
+        for (std::size_t i = 0; i < jobCount; i++)
+        {
+            RenderJob* job = m_renderJobs[i];
+
+            if (job->parallel)
+            {
+                job->list.Replay(renderer);
+                renderer->AddCulledWidgets(job->recorder.GetFrameStats().culledWidgets);
+            }
+            else
+                job->widget->DoRender(skin);
+        }
+    }
+
+    bool Canvas::IsOpaque() const
+    {
+        return m_drawBackground && m_backgroundColor.a == 255;
+    }
+
+    bool Canvas::CanRenderInParallel(const Widget* widget)
+    {
+        // Custom skins and cache textures draw with the renderer itself.
+        if (widget->m_skin != nullptr || widget->m_cacheToTexture)
+            return false;
+
+        for (auto&& child : widget->m_children)
+        {
+            if (!CanRenderInParallel(child))
+                return false;
+        }
+
+        return true;
     }
 
-    void Canvas::Render(Skin* render)
+    void Canvas::ApplyCachePolicy(Widget* parent, bool insideCache)
     {
-        m_needsRedraw = false;
+        for (auto&& child : parent->m_children)
+        {
+            const WidgetRenderStats stats = child->m_renderStats;
+            child->m_renderStats = WidgetRenderStats();
+
+            if (child->m_hidden)
+                continue;
+
+            // Widgets cached by hand are left alone.
+            const bool manual = child->m_cacheToTexture && !child->m_cacheToTextureAuto;
+            ICachePolicy::Decision decision = ICachePolicy::Decision::Keep;
+
+            // Cache textures can't be nested.
+            if (insideCache)
+                decision = child->m_cacheToTextureAuto ? ICachePolicy::Decision::Uncache : ICachePolicy::Decision::Keep;
+            else if (!manual && (child->m_cacheToTextureAuto || m_cachePolicy->IsCandidate(child)))
+                decision = m_cachePolicy->Evaluate(child, stats, child->m_cacheToTextureAuto);
+
+            if (decision == ICachePolicy::Decision::Cache && !child->m_cacheToTexture && !HasManuallyCachedChildren(child))
+            {
+                child->m_cacheToTexture = true;
+                child->m_cacheToTextureAuto = true;
+                child->m_cacheTextureDirty = true;
+            }
+            else if (decision == ICachePolicy::Decision::Uncache && child->m_cacheToTextureAuto)
+            {
+                child->DisableCacheToTexture();
+                child->Redraw();
+            }
+            else
+            {
+                decision = ICachePolicy::Decision::Keep;
+            }
+
+            if (decision != ICachePolicy::Decision::Keep)
+            {
+                EventInfo info(child);
+                info.data.boolean = child->m_cacheToTexture;
+                On(CachePolicyEvent)->Call(child, info);
+            }
+
+            ApplyCachePolicy(child, insideCache || child->m_cacheToTexture);
+        }
+    }
+
+    bool Canvas::HasManuallyCachedChildren(const Widget* widget)
+    {
+        for (auto&& child : widget->m_children)
+        {
+            if ((child->m_cacheToTexture && !child->m_cacheToTextureAuto) || HasManuallyCachedChildren(child))
+                return true;
+        }
+
+        return false;
+    }
+
+    void Canvas::Redraw()
+    {
+        AddDirtyRect(Rect(0, 0, m_bounds.w, m_bounds.h));
+    }
+
+    void Canvas::SetDirtyRectsEnabled(bool enabled)
+    {
+        if (m_dirtyRectsEnabled == enabled)
+            return;
+
+        m_dirtyRectsEnabled = enabled;
+        Redraw();
+    }
+
+    void Canvas::AddDirtyRect(const Rect& rect)
+    {
+        // Widgets rendered on worker threads may redraw themselves.
+        std::lock_guard<std::mutex> lock(m_dirtyRectMutex);
+
+        m_dirtyRect = m_dirtyRect.Union(rect);
+        m_needsRedraw = true;
     }
 
     void Canvas::OnBoundsChanged(const Rect& old)
@@ -702,6 +1034,9 @@ namespace SparkyStudios::UI::Pixel
         Skin::Data data = skin->GetSkinData();
         skin->SetDefaultFont(data.Canvas.defaultFont);
 
+        // Render jobs copy the skin again on their next use.
+        m_renderSkinVersion++;
+
         SetBackgroundColor(data.Canvas.backgroundColor);
         SetPadding(data.Canvas.padding);
     }
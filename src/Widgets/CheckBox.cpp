@@ -114,5 +114,6 @@ namespace SparkyStudios::UI::Pixel
 
         m_checked = bChecked;
         OnCheckStatusChanged();
+        Redraw();
     }
 } // namespace SparkyStudios::UI::Pixel
@@ -168,14 +168,31 @@ namespace SparkyStudios::UI::Pixel
         BaseRenderer* renderer = skin->GetRenderer();
         const Skin::Data& skinData = skin->GetSkinData();
 
+        renderer->SetDrawColor(GetBackgroundColor(skinData));
+        renderer->DrawFilledRect(RenderBounds(), skinData.Menu.radius);
+    }
+
+    bool Menu::IsOpaque() const
+    {
+        const Skin* skin = GetSkin();
+        if (skin == nullptr)
+            return false;
+
+        const Skin::Data& skinData = skin->GetSkinData();
+
+        // Rounded corners leave the corners of the bounds uncovered.
+        return GetBackgroundColor(skinData).a == 255 && skinData.Menu.radius.w == 0 && skinData.Menu.radius.h == 0;
+    }
+
+    Color Menu::GetBackgroundColor(const Skin::Data& skinData) const
+    {
         if (m_disabled)
-            renderer->SetDrawColor(skinData.Menu.backgroundColorDisabled);
-        else if (IsHovered())
-            renderer->SetDrawColor(skinData.Menu.backgroundColorHovered);
-        else
-            renderer->SetDrawColor(skinData.Menu.backgroundColorNormal);
+            return skinData.Menu.backgroundColorDisabled;
 
-        renderer->DrawFilledRect(RenderBounds(), skinData.Menu.radius);
+        if (IsHovered())
+            return skinData.Menu.backgroundColorHovered;
+
+        return skinData.Menu.backgroundColorNormal;
     }
 
     void Menu::RenderUnder(Skin* skin)
@@ -189,6 +206,16 @@ namespace SparkyStudios::UI::Pixel
         renderer->DrawFilledRect(RenderBounds() + skinData.Menu.shadowOffset, skinData.Menu.shadowRadius);
     }
 
+    Rect Menu::GetDrawBounds() const
+    {
+        const Skin* skin = GetSkin();
+        if (skin == nullptr)
+            return ParentClass::GetDrawBounds();
+
+        // Include the shadow drawn by RenderUnder().
+        return RenderBounds().Union(RenderBounds() + skin->GetSkinData().Menu.shadowOffset);
+    }
+
     void Menu::Layout(Skin* skin)
     {
         int menuHeight = 0;
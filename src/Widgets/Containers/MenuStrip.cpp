@@ -53,16 +53,29 @@ namespace SparkyStudios::UI::Pixel
     void MenuStrip::Render(Skin* skin)
     {
         BaseRenderer* renderer = skin->GetRenderer();
-        const Skin::Data& skinData = skin->GetSkinData();
 
+        renderer->SetDrawColor(GetBackgroundColor(skin->GetSkinData()));
+        renderer->DrawFilledRect(RenderBounds(), Size());
+    }
+
+    bool MenuStrip::IsOpaque() const
+    {
+        const Skin* skin = GetSkin();
+        if (skin == nullptr)
+            return false;
+
+        return GetBackgroundColor(skin->GetSkinData()).a == 255;
+    }
+
+    Color MenuStrip::GetBackgroundColor(const Skin::Data& skinData) const
+    {
         if (m_disabled)
-            renderer->SetDrawColor(skinData.MenuStrip.backgroundColorDisabled);
-        else if (IsHovered())
-            renderer->SetDrawColor(skinData.MenuStrip.backgroundColorHovered);
-        else
-            renderer->SetDrawColor(skinData.MenuStrip.backgroundColorNormal);
+            return skinData.MenuStrip.backgroundColorDisabled;
 
-        renderer->DrawFilledRect(RenderBounds(), Size());
+        if (IsHovered())
+            return skinData.MenuStrip.backgroundColorHovered;
+
+        return skinData.MenuStrip.backgroundColorNormal;
     }
 
     void MenuStrip::RenderUnder(Skin* skin)
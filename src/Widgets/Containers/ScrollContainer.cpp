@@ -872,6 +872,15 @@ namespace SparkyStudios::UI::Pixel
         renderer->DrawFilledRect(r, Size(0, 0));
     }
 
+    bool ScrollContainer::IsOpaque() const
+    {
+        const Skin* skin = GetSkin();
+        if (skin == nullptr)
+            return false;
+
+        return skin->GetSkinData().ScrollContainer.backgroundColor.a == 255;
+    }
+
     void ScrollContainer::UpdateScroll()
     {
         if (m_innerPanel == nullptr)
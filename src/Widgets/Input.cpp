@@ -27,8 +27,9 @@ namespace SparkyStudios::UI::Pixel
     class CaretColorAnimation : public Animation
     {
     public:
+        // Without transition the progress doesn't change, so the caret is only redrawn when it blinks.
         CaretColorAnimation()
-            : Animation(0.5, 0.0, TransitionFunction::Linear, true)
+            : Animation(0.5, 0.0, TransitionFunction::None, true)
         {}
 
         void OnStart() override
@@ -44,6 +45,18 @@ namespace SparkyStudios::UI::Pixel
             pi_cast<Input*>(m_widget)->SetCaretVisible(_caretVisible);
         }
 
+        [[nodiscard]] PiTime GetNextUpdateTime(PiTime time) const override
+        {
+            // Nothing changes until the caret blinks.
+            return m_started ? m_start + m_duration : time;
+        }
+
+        [[nodiscard]] bool NeedsUpdate() const override
+        {
+            // The caret is only drawn on the focused input.
+            return m_widget->IsFocused();
+        }
+
     private:
         bool _caretVisible;
     };
@@ -78,7 +91,14 @@ namespace SparkyStudios::UI::Pixel
 
     void Input::SetCaretVisible(bool visible)
     {
+        if (_caretVisible == visible)
+            return;
+
         _caretVisible = visible;
+
+        // The caret is only drawn on the focused input.
+        if (IsFocused())
+            Redraw();
     }
 
     bool Input::IsCaretVisible() const
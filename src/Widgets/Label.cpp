@@ -211,12 +211,29 @@ namespace SparkyStudios::UI::Pixel
 
     void Text::SetTextColor(const Color& col)
     {
+        if (m_color == col)
+            return;
+
         m_color = col;
+
+        for (auto&& line : m_lines)
+            line->SetTextColor(col);
+
+        Redraw();
     }
 
     void Text::SetTextColorOverride(const Color& col)
     {
+        // Widgets set the override from their state while rendering, so only actual changes are redrawn.
+        if (m_colorOverride == col)
+            return;
+
         m_colorOverride = col;
+
+        for (auto&& line : m_lines)
+            line->SetTextColorOverride(col);
+
+        Redraw();
     }
 
     const Color& Text::TextColor() const
@@ -46,6 +46,13 @@ namespace SparkyStudios::UI::Pixel
             // m_reverse = !m_reverse;
         }
 
+        [[nodiscard]] bool NeedsUpdate() const override
+        {
+            // Determined progress bars don't move.
+            const auto* p = pi_cast<ProgressBar*>(m_widget);
+            return p->IsUndetermined() && p->IsVisible();
+        }
+
         bool m_reverse;
     };
 
@@ -90,6 +97,7 @@ namespace SparkyStudios::UI::Pixel
     void ProgressBar::SetDirection(ProgressBar::Direction direction)
     {
         m_direction = direction;
+        Redraw();
     }
 
     ProgressBar::Direction ProgressBar::GetDirection() const
@@ -117,6 +125,8 @@ namespace SparkyStudios::UI::Pixel
             const PiInt32 displayValue = static_cast<PiInt32>(m_progress * 100.0);
             SetText(Utility::ToString(displayValue) + "%");
         }
+
+        Redraw();
     }
 
     PiReal64 ProgressBar::GetProgress() const
@@ -148,6 +158,7 @@ namespace SparkyStudios::UI::Pixel
     {
         m_undetermined = value;
         AutoLabel(!value);
+        Redraw();
     }
 
     bool ProgressBar::IsUndetermined() const
@@ -33,11 +33,17 @@ namespace SparkyStudios::UI::Pixel
     void BaseShape::DrawBackground(bool value)
     {
         m_drawBackground = value;
+        Redraw();
     }
 
     void BaseShape::SetBackgroundColor(const Color& color)
     {
+        // Parents set the color of their shapes from their state while rendering, so only actual changes are redrawn.
+        if (m_backgroundColor == color)
+            return;
+
         m_backgroundColor = color;
+        Redraw();
     }
 
     void BaseShape::DrawBorder(bool value)
@@ -47,8 +53,12 @@ namespace SparkyStudios::UI::Pixel
 
     void BaseShape::SetBorder(const Color& color, PiUInt32 thickness)
     {
+        if (m_borderColor == color && m_borderThickness == thickness)
+            return;
+
         m_borderColor = color;
         m_borderThickness = thickness;
+        Redraw();
     }
 
     Widget* BaseShape::GetWidgetAt(PiInt32 x, PiInt32 y, bool onlyIfMouseEnabled)
@@ -45,15 +45,27 @@ namespace SparkyStudios::UI::Pixel
     void StatusBar::Render(Skin* skin)
     {
         BaseRenderer* renderer = skin->GetRenderer();
-        const Skin::Data& skinData = skin->GetSkinData();
 
         const Rect& rect = RenderBounds();
 
+        renderer->SetDrawColor(GetBackgroundColor(skin->GetSkinData()));
+        renderer->DrawFilledRect(rect, Size(0, 0));
+    }
+
+    bool StatusBar::IsOpaque() const
+    {
+        const Skin* skin = GetSkin();
+        if (skin == nullptr)
+            return false;
+
+        return GetBackgroundColor(skin->GetSkinData()).a == 255;
+    }
+
+    Color StatusBar::GetBackgroundColor(const Skin::Data& skinData) const
+    {
         if (m_disabled)
-            renderer->SetDrawColor(skinData.StatusBar.backgroundColorDisabled);
-        else
-            renderer->SetDrawColor(skinData.StatusBar.backgroundColorNormal);
+            return skinData.StatusBar.backgroundColorDisabled;
 
-        renderer->DrawFilledRect(rect, Size(0, 0));
+        return skinData.StatusBar.backgroundColorNormal;
     }
 } // namespace SparkyStudios::UI::Pixel
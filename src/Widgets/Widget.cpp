@@ -25,6 +25,9 @@
 
 namespace SparkyStudios::UI::Pixel
 {
+    // The widgets to redraw once the render workers of the canvas are done, set on those threads only.
+    static thread_local std::vector<Widget*>* gRecordedRedraws = nullptr;
+
     const char* const Widget::MouseEnterEvent = "Widget::Events::MouseEnter";
     const char* const Widget::MouseLeaveEvent = "Widget::Events::MouseLeave";
     const char* const Widget::MouseButtonDownEvent = "Widget::Events::MouseButtonDown";
@@ -46,6 +49,8 @@ namespace SparkyStudios::UI::Pixel
         , m_disabled(false)
         , m_cacheTextureDirty(true)
         , m_cacheToTexture(false)
+        , m_cacheToTextureAuto(false)
+        , m_displayListDirty(true)
         , m_includeInSize(true)
         , m_tooltip(nullptr)
         , m_name(std::move(name))
@@ -64,6 +69,9 @@ namespace SparkyStudios::UI::Pixel
 
     Widget::~Widget()
     {
+        if (m_cacheToTexture)
+            DisableCacheToTexture();
+
         {
             Canvas* canvas = GetCanvas();
 
@@ -149,7 +157,11 @@ namespace SparkyStudios::UI::Pixel
             return;
 
         if (m_parent)
+        {
+            // Damage the area left by this widget.
+            Redraw();
             m_parent->RemoveChild(this);
+        }
 
         m_parent = parent;
         m_actualParent = nullptr;
@@ -818,11 +830,17 @@ namespace SparkyStudios::UI::Pixel
     void Widget::EnableCacheToTexture()
     {
         m_cacheToTexture = true;
+        m_cacheToTextureAuto = false;
     }
 
     void Widget::DisableCacheToTexture()
     {
         m_cacheToTexture = false;
+        m_cacheToTextureAuto = false;
+        m_cacheTextureDirty = true;
+
+        if (Skin* skin = GetSkin(); skin != nullptr && skin->GetRenderer()->GetCTT() != nullptr)
+            skin->GetRenderer()->GetCTT()->FreeWidgetCacheTexture(this);
     }
 
     bool Widget::IsCachedToTextureEnabled() const
@@ -830,6 +848,11 @@ namespace SparkyStudios::UI::Pixel
         return m_cacheToTexture;
     }
 
+    const WidgetRenderStats& Widget::GetRenderStats() const
+    {
+        return m_renderStats;
+    }
+
     bool Widget::NeedsLayout() const
     {
         return m_needsLayout;
@@ -838,7 +861,13 @@ namespace SparkyStudios::UI::Pixel
     void Widget::Invalidate()
     {
         m_needsLayout = true;
-        m_cacheTextureDirty = true;
+        m_displayListDirty = true;
+
+        // Cached parents hold an image of this widget too.
+        for (Widget* widget = this; widget != nullptr; widget = widget->m_parent)
+            widget->m_cacheTextureDirty = true;
+
+        AddDirtyRegion(GetDrawBounds());
     }
 
     void Widget::InvalidateParent()
@@ -972,11 +1001,21 @@ namespace SparkyStudios::UI::Pixel
         if (m_parent != nullptr)
             m_parent->NotifyBoundsChanged(old, this);
 
-        if (m_bounds.w != old.w || m_bounds.h != old.h)
+        // The area covered at the previous position needs to be redrawn as well.
+        const Point shift(old.x - m_bounds.x, old.y - m_bounds.y);
+        AddDirtyRegion((GetDrawBounds() + shift).Union(Rect(shift.x, shift.y, old.w, old.h)));
+
+        UpdateRenderBounds();
+
+        // Display lists are replayed at the current position, only a new size needs them to be recorded again.
+        const bool resized = m_bounds.w != old.w || m_bounds.h != old.h;
+        const bool displayListDirty = m_displayListDirty || resized;
+
+        if (resized)
             Invalidate();
 
         Redraw();
-        UpdateRenderBounds();
+        m_displayListDirty = displayListDirty;
     }
 
     void Widget::OnScaleChanged()
@@ -1125,25 +1164,44 @@ namespace SparkyStudios::UI::Pixel
         return true;
     }
 
+    void Widget::SetRecordingThread(std::vector<Widget*>* redraws)
+    {
+        gRecordedRedraws = redraws;
+    }
+
+    void Widget::ThinkRecursive()
+    {
+        Think();
+
+        for (auto&& child : m_children)
+        {
+            if (!child->m_hidden)
+                child->ThinkRecursive();
+        }
+    }
+
     void Widget::DoRender(Skin* skin)
     {
         // Use the custom widget skin if any
         if (m_skin != nullptr)
             skin = m_skin;
 
-        Think();
+        // Recording threads have thought on the main thread beforehand.
+        if (gRecordedRedraws == nullptr)
+            Think();
+
         BaseRenderer* renderer = skin->GetRenderer();
 
         if (renderer->GetCTT() != nullptr && IsCachedToTextureEnabled())
         {
-            DoCacheRender(skin, this);
+            DoCacheRender(skin);
             return;
         }
 
         RenderRecursive(skin);
     }
 
-    void Widget::DoCacheRender(Skin* skin, Widget* root)
+    void Widget::DoCacheRender(Skin* skin)
     {
         BaseRenderer* renderer = skin->GetRenderer();
         ICacheToTexture* cache = renderer->GetCTT();
@@ -1151,56 +1209,61 @@ namespace SparkyStudios::UI::Pixel
         if (cache == nullptr)
             return;
 
-        Point oldOffset = renderer->GetRenderOffset();
-        Rect oldRegion = renderer->ClipRegion();
-
-        if (this != root)
-        {
-            renderer->AddRenderOffset(m_bounds);
-            renderer->AddClipRegion(m_bounds);
-        }
-        else
+        // Render directly when the cache is out of memory.
+        if (!cache->CreateWidgetCacheTexture(this, m_bounds.GetSize()))
         {
-            renderer->SetRenderOffset(Point(0, 0));
-            renderer->SetClipRegion(m_bounds);
+            RenderRecursive(skin);
+            return;
         }
 
-        if (m_cacheTextureDirty && renderer->ClipRegionVisible())
+        // The texture is new, or has been reallocated.
+        if (!cache->IsWidgetCacheTextureValid(this))
+            m_cacheTextureDirty = true;
+
+        Point oldOffset = renderer->GetRenderOffset();
+
+        m_renderStats.frames++;
+
+        if (m_cacheTextureDirty)
         {
+            const PiUInt32 primitives = renderer->GetFrameStats().primitives;
+            const Rect oldRegion = renderer->ClipRegion();
+
+            // Switch to the cache bitmap first, so the clip is applied to it.
+            cache->SetupCacheTexture(this);
+
+            // The widget is drawn at the origin of its bitmap, where the clip of its parents doesn't apply.
+            renderer->SetRenderOffset(Point(0, 0));
+            renderer->SetClipRegion(Rect(0, 0, m_bounds.w, m_bounds.h));
             renderer->StartClip();
-            {
-                if (IsCachedToTextureEnabled())
-                    cache->SetupCacheTexture(this);
 
-                Render(skin);
+            RenderWithDisplayList(skin);
+            RenderChildren(skin);
 
-                if (!m_children.empty())
-                {
-                    for (auto&& child : m_children)
-                    {
-                        if (!child->m_hidden)
-                        {
-                            child->DoRender(skin);
-                        }
-                    }
-                }
+            cache->FinishCacheTexture(this);
+            m_cacheTextureDirty = false;
 
-                if (IsCachedToTextureEnabled())
-                {
-                    cache->FinishCacheTexture(this);
-                    m_cacheTextureDirty = false;
-                }
-            }
-            renderer->EndClip();
+            renderer->SetClipRegion(oldRegion);
+            renderer->StartClip();
+
+            m_renderStats.renders++;
+            m_renderStats.changes++;
+            m_renderStats.primitives += renderer->GetFrameStats().primitives - primitives;
         }
 
-        renderer->SetClipRegion(oldRegion);
-        renderer->StartClip();
+        renderer->SetRenderOffset(oldOffset);
+
+        // Never draw a texture which doesn't hold the widget.
+        if (!cache->IsWidgetCacheTextureValid(this))
         {
-            renderer->SetRenderOffset(oldOffset);
-            cache->DrawCachedWidgetTexture(this);
+            m_cacheTextureDirty = true;
+            RenderRecursive(skin);
+            return;
         }
-        renderer->EndClip();
+
+        renderer->AddRenderOffset(m_bounds);
+        cache->DrawCachedWidgetTexture(this);
+        renderer->SetRenderOffset(oldOffset);
     }
 
     void Widget::RenderRecursive(Skin* skin)
@@ -1211,49 +1274,145 @@ namespace SparkyStudios::UI::Pixel
         renderer->AddRenderOffset(m_bounds);
         RenderUnder(skin);
 
-        Rect oldRegion = renderer->ClipRegion();
-
         // If this control is clipping, change the clip rect to ourselves
         // else clip using our parents clip rect.
-        if (ShouldClip())
+        const bool clip = ShouldClip();
+
+        if (clip)
         {
-            renderer->AddClipRegion(RenderBounds());
+            renderer->PushClip(RenderBounds());
 
             if (!renderer->ClipRegionVisible())
             {
+                renderer->PopClip();
                 renderer->SetRenderOffset(oldOffset);
-                renderer->SetClipRegion(oldRegion);
                 return;
             }
         }
 
+        const PiUInt32 primitives = renderer->GetFrameStats().primitives;
+
         // Render this control and children controls
-        renderer->StartClip();
         {
-            Render(skin);
+            RenderWithDisplayList(skin);
+            RenderChildren(skin);
+        }
+
+        if (clip)
+            renderer->PopClip();
+
+        // Render overlay/focus, clipped by the parent
+        {
+            RenderOverlay(skin);
+            RenderFocus(skin);
+        }
 
-            if (!m_children.empty())
+        renderer->SetRenderOffset(oldOffset);
+
+        m_renderStats.frames++;
+        m_renderStats.renders++;
+        m_renderStats.primitives += renderer->GetFrameStats().primitives - primitives;
+
+        // The flag tells the cache policy whether the widget has changed since the previous frame.
+        if (m_cacheTextureDirty)
+            m_renderStats.changes++;
+
+        m_cacheTextureDirty = false;
+    }
+
+    void Widget::RenderChildren(Skin* skin)
+    {
+        std::vector<bool> occluded;
+        FindOccludedChildren(occluded);
+
+        std::size_t index = 0;
+        for (auto it = m_children.cbegin(); it != m_children.cend(); ++it, ++index)
+        {
+            Widget* child = *it;
+
+            if (child->m_hidden)
+                continue;
+
+            if (!occluded.empty() && occluded[index])
             {
-                for (auto&& child : m_children)
+                // Occluded widgets aren't drawn, but still think. Recording threads have thought beforehand.
+                if (gRecordedRedraws == nullptr)
+                    child->ThinkRecursive();
+
+                skin->GetRenderer()->AddCulledWidgets(1);
+                continue;
+            }
+
+            child->DoRender(skin);
+        }
+    }
+
+    void Widget::FindOccludedChildren(std::vector<bool>& occluded) const
+    {
+        occluded.clear();
+
+        std::vector<Rect> occluders;
+        std::size_t index = m_children.size();
+
+        for (auto it = m_children.crbegin(); it != m_children.crend(); ++it)
+        {
+            const Widget* child = *it;
+            index--;
+
+            if (child->m_hidden)
+                continue;
+
+            if (!occluders.empty())
+            {
+                const Rect drawBounds = child->GetDrawBounds() + child->m_bounds.GetPosition();
+
+                if (std::any_of(
+                        occluders.cbegin(), occluders.cend(),
+                        [&drawBounds](const Rect& occluder)
+                        {
+                            return occluder.Contains(drawBounds);
+                        }))
                 {
-                    if (child->m_hidden)
-                        continue;
+                    if (occluded.empty())
+                        occluded.resize(m_children.size(), false);
 
-                    child->DoRender(skin);
+                    // Its bounds are covered already, so it doesn't occlude anything more.
+                    occluded[index] = true;
+                    continue;
                 }
             }
+
+            if (child->IsOpaque())
+                occluders.push_back(child->m_bounds);
         }
-        renderer->EndClip();
+    }
 
-        // Render overlay/focus
-        renderer->SetClipRegion(oldRegion);
-        renderer->StartClip();
+    void Widget::RenderWithDisplayList(Skin* skin)
+    {
+        BaseRenderer* renderer = skin->GetRenderer();
+        DisplayListRecorder* recorder = renderer->GetDisplayListRecorder();
+
+        if (recorder == nullptr)
         {
-            RenderOverlay(skin);
-            RenderFocus(skin);
+            Render(skin);
+            return;
         }
-        renderer->EndClip();
-        renderer->SetRenderOffset(oldOffset);
+
+        if (m_displayListDirty)
+        {
+            // Cleared first, so that a redraw requested while rendering records the widget again next frame.
+            m_displayListDirty = false;
+            m_displayList.Clear();
+
+            // Record the draw operations, the widget renders through the skin renderer.
+            recorder->SetDisplayList(&m_displayList);
+            skin->SetRenderer(recorder);
+            Render(skin);
+            skin->SetRenderer(renderer);
+            recorder->SetDisplayList(nullptr);
+        }
+
+        m_displayList.Replay(renderer);
     }
 
     void Widget::Render(Skin* skin)
@@ -1270,10 +1429,42 @@ namespace SparkyStudios::UI::Pixel
 
     void Widget::Redraw()
     {
-        m_cacheTextureDirty = true;
+        if (gRecordedRedraws != nullptr)
+        {
+            gRecordedRedraws->push_back(this);
+            return;
+        }
 
-        if (m_parent != nullptr)
-            m_parent->Redraw();
+        m_displayListDirty = true;
+
+        // Only the area of this widget is damaged, so walk up to the root without calling Redraw() on each parent.
+        Widget* root = this;
+        while (root->m_parent != nullptr)
+        {
+            root->m_cacheTextureDirty = true;
+            root = root->m_parent;
+        }
+
+        if (auto* canvas = pi_cast<Canvas*>(root); canvas != nullptr)
+            canvas->AddDirtyRect(GetDrawBounds() + LocalPositionToWindow(Point(0, 0)));
+        else
+            root->m_cacheTextureDirty = true;
+    }
+
+    Rect Widget::GetDrawBounds() const
+    {
+        return RenderBounds();
+    }
+
+    bool Widget::IsOpaque() const
+    {
+        return false;
+    }
+
+    void Widget::AddDirtyRegion(const Rect& region)
+    {
+        if (Canvas* canvas = GetCanvas(); canvas != nullptr)
+            canvas->AddDirtyRect(region + LocalPositionToWindow(Point(0, 0)));
     }
 
     void Widget::Layout(Skin* skin)
@@ -0,0 +1,266 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Rasterizes a TrueType font at the given pixel sizes into a baked font file.
+//
+// Usage: FontBaker [-k] [-r <first>-<last>]... <output file> <font file> <pixel size>...
+//
+//   -k  Bakes the kerning pairs. The renderer loads TrueType fonts without kerning.
+//   -r  Bakes the given range of codepoints, instead of the default 32-126 and 160-255 ranges.
+//
+// The renderer loads fonts at their size multiplied by the UI scale, bake every size used
+// at every scale. The baked font file must be named after the TrueType font, with the .pifn
+// extension, eg. "OpenSans.pifn" for "OpenSans.ttf".
+
+#include <SparkyStudios/UI/Pixel/Core/Renderer/AtlasPacker.h>
+
+#include <Core/Allegro5/Renderer/BakedFont.h>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <allegro5/allegro_ttf.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace SparkyStudios::UI::Pixel;
+
+static constexpr PiInt32 kMinAtlasSize = 128;
+static constexpr PiInt32 kMaxAtlasSize = 4096;
+static constexpr PiInt32 kGlyphPadding = 1;
+
+struct Range
+{
+    PiInt32 first;
+    PiInt32 last;
+};
+
+static bool PackGlyphs(std::vector<BakedFont_Allegro::Glyph>& glyphs, PiInt32 atlasSize, PiUInt32& atlasHeight)
+{
+    AtlasPacker packer(atlasSize, atlasSize, kGlyphPadding);
+    atlasHeight = 0;
+
+    for (auto&& glyph : glyphs)
+    {
+        if (glyph.w == 0 || glyph.h == 0)
+            continue;
+
+        Rect region;
+        if (!packer.Pack(glyph.w, glyph.h, region))
+            return false;
+
+        glyph.x = static_cast<PiUInt16>(region.x);
+        glyph.y = static_cast<PiUInt16>(region.y);
+        atlasHeight = std::max(atlasHeight, static_cast<PiUInt32>(region.y + glyph.h));
+    }
+
+    return true;
+}
+
+static bool BakeFace(const char* fontPath, PiInt32 pixelSize, const std::vector<Range>& ranges, bool kerning, BakedFont_Allegro::Face& face)
+{
+    ALLEGRO_FONT* font = al_load_ttf_font(fontPath, pixelSize, ALLEGRO_TTF_NO_KERNING);
+
+    if (font == nullptr)
+    {
+        std::fprintf(stderr, "Unable to load the font %s\n", fontPath);
+        return false;
+    }
+
+    face.pixelSize = pixelSize;
+    face.lineHeight = al_get_font_line_height(font);
+
+    // Glyph metrics
+    for (auto&& range : ranges)
+    {
+        for (PiInt32 codepoint = range.first; codepoint <= range.last; ++codepoint)
+        {
+            int bbx = 0, bby = 0, bbw = 0, bbh = 0;
+            const bool visible = al_get_glyph_dimensions(font, codepoint, &bbx, &bby, &bbw, &bbh);
+            const int advance = al_get_glyph_advance(font, codepoint, ALLEGRO_NO_KERNING);
+
+            if (!visible && advance <= 0)
+                continue;
+
+            BakedFont_Allegro::Glyph glyph = {};
+            glyph.codepoint = static_cast<PiUInt32>(codepoint);
+            glyph.w = static_cast<PiUInt16>(visible ? bbw : 0);
+            glyph.h = static_cast<PiUInt16>(visible ? bbh : 0);
+            glyph.offsetX = static_cast<PiInt16>(bbx);
+            glyph.offsetY = static_cast<PiInt16>(bby);
+            glyph.advance = static_cast<PiInt16>(advance);
+
+            face.glyphs.push_back(glyph);
+        }
+    }
+
+    std::sort(
+        face.glyphs.begin(), face.glyphs.end(),
+        [](const BakedFont_Allegro::Glyph& a, const BakedFont_Allegro::Glyph& b)
+        {
+            return a.codepoint < b.codepoint;
+        });
+
+    // Atlas layout, in the smallest square page which fits every glyph
+    PiInt32 atlasSize = kMinAtlasSize;
+
+    while (!PackGlyphs(face.glyphs, atlasSize, face.atlasHeight))
+    {
+        atlasSize *= 2;
+
+        if (atlasSize > kMaxAtlasSize)
+        {
+            std::fprintf(stderr, "The glyphs of the size %d don't fit in a %dx%d atlas\n", pixelSize, kMaxAtlasSize, kMaxAtlasSize);
+            al_destroy_font(font);
+            return false;
+        }
+    }
+
+    face.atlasWidth = static_cast<PiUInt32>(atlasSize);
+    face.atlasHeight = std::max<PiUInt32>(face.atlasHeight, 1);
+
+    // Atlas coverage
+    ALLEGRO_BITMAP* atlas = al_create_bitmap(static_cast<int>(face.atlasWidth), static_cast<int>(face.atlasHeight));
+    al_set_target_bitmap(atlas);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+
+    for (auto&& glyph : face.glyphs)
+    {
+        if (glyph.w > 0 && glyph.h > 0)
+            al_draw_glyph(font, al_map_rgb(255, 255, 255), glyph.x - glyph.offsetX, glyph.y - glyph.offsetY, glyph.codepoint);
+    }
+
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(atlas, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    face.coverage.resize(static_cast<std::size_t>(face.atlasWidth) * face.atlasHeight);
+
+    const auto* row = static_cast<const PiUInt8*>(region->data);
+    for (PiUInt32 y = 0; y < face.atlasHeight; ++y, row += region->pitch)
+    {
+        for (PiUInt32 x = 0; x < face.atlasWidth; ++x)
+            face.coverage[y * face.atlasWidth + x] = row[x * 4 + 3];
+    }
+
+    al_unlock_bitmap(atlas);
+    al_set_target_bitmap(nullptr);
+    al_destroy_bitmap(atlas);
+    al_destroy_font(font);
+
+    // Kerning pairs
+    if (kerning)
+    {
+        ALLEGRO_FONT* kerned = al_load_ttf_font(fontPath, pixelSize, 0);
+
+        for (auto&& first : face.glyphs)
+        {
+            const int advance = al_get_glyph_advance(kerned, first.codepoint, ALLEGRO_NO_KERNING);
+
+            for (auto&& second : face.glyphs)
+            {
+                const int amount = al_get_glyph_advance(kerned, first.codepoint, second.codepoint) - advance;
+
+                if (amount != 0)
+                    face.kerning.push_back({ first.codepoint, second.codepoint, amount });
+            }
+        }
+
+        al_destroy_font(kerned);
+    }
+
+    std::printf(
+        "Baked %zu glyphs and %zu kerning pairs at %dpx in a %ux%u atlas\n", face.glyphs.size(), face.kerning.size(), pixelSize,
+        face.atlasWidth, face.atlasHeight);
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Range> ranges;
+    bool kerning = false;
+    int arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-'; ++arg)
+    {
+        if (std::strcmp(argv[arg], "-k") == 0)
+        {
+            kerning = true;
+        }
+        else if (std::strcmp(argv[arg], "-r") == 0 && arg + 1 < argc)
+        {
+            Range range;
+            if (std::sscanf(argv[++arg], "%d-%d", &range.first, &range.last) != 2 || range.first > range.last)
+            {
+                std::fprintf(stderr, "Invalid codepoint range: %s\n", argv[arg]);
+                return 1;
+            }
+
+            ranges.push_back(range);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option: %s\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (argc - arg < 3)
+    {
+        std::fprintf(stderr, "Usage: %s [-k] [-r <first>-<last>]... <output file> <font file> <pixel size>...\n", argv[0]);
+        return 1;
+    }
+
+    if (ranges.empty())
+        ranges = { { 32, 126 }, { 160, 255 } };
+
+    const char* output = argv[arg++];
+    const char* fontPath = argv[arg++];
+
+    if (!al_init() || !al_init_font_addon() || !al_init_ttf_addon())
+    {
+        std::fprintf(stderr, "Unable to initialize Allegro\n");
+        return 1;
+    }
+
+    // Glyphs are rasterized without a display.
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+
+    std::vector<BakedFont_Allegro::Face> faces;
+
+    for (; arg < argc; ++arg)
+    {
+        const PiInt32 pixelSize = std::atoi(argv[arg]);
+
+        if (pixelSize <= 0)
+        {
+            std::fprintf(stderr, "Invalid pixel size: %s\n", argv[arg]);
+            return 1;
+        }
+
+        BakedFont_Allegro::Face face;
+        if (!BakeFace(fontPath, pixelSize, ranges, kerning, face))
+            return 1;
+
+        faces.push_back(std::move(face));
+    }
+
+    if (!BakedFont_Allegro::Write(output, faces))
+    {
+        std::fprintf(stderr, "Unable to write the baked font %s\n", output);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2021-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Bundles the fonts and textures of a resource directory in a resource pack.
+//
+// Usage: ResourcePacker <output file> <resource directory>
+//
+// Resources are named by their path relative to the resource directory, using '/' as separator.
+
+#include <SparkyStudios/UI/Pixel/Core/ResourcePack.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+
+using namespace SparkyStudios::UI::Pixel;
+
+static ResourcePaths::Type GetResourceType(const std::filesystem::path& path)
+{
+    PiString extension = path.extension().string();
+    std::transform(
+        extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c)
+        {
+            return static_cast<char>(std::tolower(c));
+        });
+
+    if (extension == ".ttf")
+        return ResourcePaths::Type::Font;
+
+    if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".tga" ||
+        extension == ".pcx" || extension == ".webp")
+        return ResourcePaths::Type::Texture;
+
+    return ResourcePaths::Type::Other;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "Usage: %s <output file> <resource directory>\n", argv[0]);
+        return 1;
+    }
+
+    const std::filesystem::path root(argv[2]);
+    std::error_code error;
+
+    std::vector<ResourcePack::Source> sources;
+
+    for (auto&& entry : std::filesystem::recursive_directory_iterator(root, error))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        ResourcePack::Source source;
+        source.type = GetResourceType(entry.path());
+        source.name = entry.path().lexically_relative(root).generic_string();
+        source.path = entry.path().string();
+
+        sources.push_back(source);
+    }
+
+    if (error)
+    {
+        std::fprintf(stderr, "Unable to read the resource directory %s: %s\n", argv[2], error.message().c_str());
+        return 1;
+    }
+
+    // Sort the resources for reproducible packs.
+    std::sort(
+        sources.begin(), sources.end(),
+        [](const ResourcePack::Source& a, const ResourcePack::Source& b)
+        {
+            return a.name < b.name;
+        });
+
+    if (!ResourcePack::Write(argv[1], sources))
+    {
+        std::fprintf(stderr, "Unable to write the resource pack %s\n", argv[1]);
+        return 1;
+    }
+
+    std::printf("Packed %zu resources in %s\n", sources.size(), argv[1]);
+    return 0;
+}